@@ -16,12 +16,12 @@ void Application::InitVariables(void)
 	//creeper
 	m_pCreeper = new Model();
 	m_pCreeper->Load("Minecraft\\Creeper.obj");
-	m_pCreeperRB = new MyRigidBody(m_pCreeper->GetVertexList());
+	m_pCreeperRB = new MyRigidBody(m_pCreeper->GetVertexList(), BV_FIT_TIGHT, m_pCreeper->GetName());
 
 	//steve
 	m_pSteve = new Model();
 	m_pSteve->Load("Minecraft\\Steve.obj");
-	m_pSteveRB = new MyRigidBody(m_pSteve->GetVertexList());
+	m_pSteveRB = new MyRigidBody(m_pSteve->GetVertexList(), BV_FIT_TIGHT, m_pSteve->GetName());
 }
 void Application::Update(void)
 {
@@ -59,6 +59,16 @@ void Application::Update(void)
 		m_pMeshMngr->PrintLine("YES!", C_RED);
 	else
 		m_pMeshMngr->PrintLine("no", C_YELLOW);
+
+	//the batch tests many pairs at once, here it only has the one pair to find its separating axis
+	m_OBBBatch.Clear();
+	uint uCreeper = m_OBBBatch.Add(m_pCreeperRB);
+	uint uSteve = m_OBBBatch.Add(m_pSteveRB);
+	m_lPairList.clear();
+	m_lPairList.push_back(BodyPair(uCreeper, uSteve));
+	m_OBBBatch.SAT(m_lPairList, m_lSATResult);
+	m_pMeshMngr->Print("Separating axis: ");
+	m_pMeshMngr->PrintLine(std::to_string(m_lSATResult[0]), C_YELLOW);
 }
 void Application::Display(void)
 {
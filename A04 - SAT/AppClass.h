@@ -10,7 +10,7 @@ Date: 2017/06
 #include "ControllerConfiguration.h"
 #include "imgui\ImGuiObject.h"
 
-#include "MyRigidBody.h"
+#include "MyOBBBatch.h"
 
 namespace Simplex
 {
@@ -26,6 +26,10 @@ class Application
 	MyRigidBody* m_pCreeperRB = nullptr; //Rigid Body of the model
 	MyRigidBody* m_pSteveRB = nullptr; //Rigid Body of the model
 
+	MyOBBBatch m_OBBBatch; //boxes of the rigid bodies for the batched SAT
+	std::vector<BodyPair> m_lPairList; //pairs of boxes tested by the batch
+	std::vector<uint> m_lSATResult; //eSATResults of each pair
+
 	String m_sProgrammer = "Alberto Bobadilla - labigm@rit.edu"; //programmer
 private:
 	static ImGuiObject gui; //GUI object
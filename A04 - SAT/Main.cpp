@@ -1,9 +1,36 @@
 // Include standard headers
 #include "Main.h"
+#include <cstdio>
 
-int main(void)
+/*
+USAGE: Runs the batched SAT against the scalar one in the build being run (Release included, the paths can
+only differ with the optimizer on) and prints how many pairs differ; the counts that are not
+multiples of 8 or 4 also check the pairs the scalar path finishes
+ARGUMENTS: ---
+OUTPUT: 0 if every pair agrees, 1 otherwise
+*/
+int CheckBatchSAT(void)
 {
 	using namespace Simplex;
+	MyOBBBatch batch;
+	uint uPairCount[] = { 1, 3, 7, 13, 1021, 4099 };
+	uint uTotal = 0;
+	for (uint i = 0; i < 6; i++)
+	{
+		uint uMismatch = batch.CompareWithScalar(uPairCount[i], i);
+		printf("SAT check: %u pairs, %u mismatches\n", uPairCount[i], uMismatch);
+		uTotal += uMismatch;
+	}
+	return uTotal == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace Simplex;
+	//"-checksat" only runs the check, without opening the window
+	if (argc > 1 && String(argv[1]) == "-checksat")
+		return CheckBatchSAT();
+
 	Application* pApp = new Application();
 	pApp->Init("", RES_C_1280x720_16x9_HD, false, false);
 	pApp->Run();
@@ -0,0 +1,264 @@
+#include "MyOBBBatch.h"
+#include "MyOBBBatchKernel.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MY_SAT_SSE
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+using namespace Simplex;
+
+static_assert(SAT_KERNEL_AX == eSATResults::SAT_AX && SAT_KERNEL_BX == eSATResults::SAT_BX &&
+	SAT_KERNEL_AXxBX == eSATResults::SAT_AXxBX, "the kernel has to mark the same axes as MyRigidBody::SAT");
+
+namespace
+{
+	//one pair at a time, the reference for the other paths
+	struct ScalarLanes
+	{
+		typedef float Float;
+		typedef bool Mask;
+		typedef uint Result;
+		static const uint m_uWidth = 1;
+
+		static Float Load(float const* a_pList, uint const* a_pIndex) { return a_pList[a_pIndex[0]]; }
+		static Float Set(float a_fValue) { return a_fValue; }
+		static Float Add(Float a, Float b) { return a + b; }
+		static Float Sub(Float a, Float b) { return a - b; }
+		static Float Mul(Float a, Float b) { return a * b; }
+		static Float Abs(Float a) { return std::abs(a); }
+		static Mask Greater(Float a, Float b) { return a > b; }
+		static Result Zero(void) { return 0; }
+		static void Mark(Result& a_Result, Mask a_bSeparated, uint a_uAxis) { if (a_Result == 0 && a_bSeparated) a_Result = a_uAxis; }
+		static bool AllMarked(Result a_Result) { return a_Result != 0; }
+		static void Store(uint* a_pOut, Result a_Result) { a_pOut[0] = a_Result; }
+	};
+
+#ifdef MY_SAT_SSE
+	//four pairs at a time
+	struct SSELanes
+	{
+		typedef __m128 Float;
+		typedef __m128 Mask;
+		typedef __m128i Result;
+		static const uint m_uWidth = 4;
+
+		static Float Load(float const* a_pList, uint const* a_pIndex)
+		{
+			return _mm_set_ps(a_pList[a_pIndex[3]], a_pList[a_pIndex[2]], a_pList[a_pIndex[1]], a_pList[a_pIndex[0]]);
+		}
+		static Float Set(float a_fValue) { return _mm_set1_ps(a_fValue); }
+		static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+		static Float Abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		static Mask Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+		static Result Zero(void) { return _mm_setzero_si128(); }
+		static void Mark(Result& a_Result, Mask a_bSeparated, uint a_uAxis)
+		{
+			//only lanes that had no axis yet take this one
+			__m128i free = _mm_cmpeq_epi32(a_Result, _mm_setzero_si128());
+			__m128i take = _mm_and_si128(free, _mm_castps_si128(a_bSeparated));
+			a_Result = _mm_or_si128(a_Result, _mm_and_si128(take, _mm_set1_epi32(a_uAxis)));
+		}
+		static bool AllMarked(Result a_Result) { return _mm_movemask_epi8(_mm_cmpeq_epi32(a_Result, _mm_setzero_si128())) == 0; }
+		static void Store(uint* a_pOut, Result a_Result) { _mm_storeu_si128(reinterpret_cast<__m128i*>(a_pOut), a_Result); }
+	};
+#endif
+
+	//the AVX2 kernel only runs if the processor and the system support AVX2
+	bool HasAVX2(void)
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		int nInfo[4];
+		__cpuid(nInfo, 0);
+		if (nInfo[0] < 7)
+			return false;
+		__cpuid(nInfo, 1);
+		bool bOSXSave = (nInfo[2] & (1 << 27)) != 0;
+		bool bAVX = (nInfo[2] & (1 << 28)) != 0;
+		if (!bOSXSave || !bAVX)
+			return false;
+		//the system has to keep the 256 bit registers between threads
+		if ((_xgetbv(0) & 6) != 6)
+			return false;
+		__cpuidex(nInfo, 7, 0);
+		return (nInfo[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		return __builtin_cpu_supports("avx2") != 0;
+#else
+		return false;
+#endif
+	}
+}
+
+//  MyOBBBatch
+void MyOBBBatch::Init(void)
+{
+	Clear();
+}
+void MyOBBBatch::Swap(MyOBBBatch& other)
+{
+	for (uint i = 0; i < 3; i++)
+	{
+		std::swap(m_lCenter[i], other.m_lCenter[i]);
+		std::swap(m_lHalfWidth[i], other.m_lHalfWidth[i]);
+	}
+	for (uint i = 0; i < 9; i++)
+		std::swap(m_lAxis[i], other.m_lAxis[i]);
+	std::swap(m_lFirst, other.m_lFirst);
+	std::swap(m_lSecond, other.m_lSecond);
+}
+void MyOBBBatch::Release(void)
+{
+	Clear();
+}
+//The big 3
+MyOBBBatch::MyOBBBatch(void)
+{
+	Init();
+}
+MyOBBBatch::MyOBBBatch(MyOBBBatch const& other)
+{
+	for (uint i = 0; i < 3; i++)
+	{
+		m_lCenter[i] = other.m_lCenter[i];
+		m_lHalfWidth[i] = other.m_lHalfWidth[i];
+	}
+	for (uint i = 0; i < 9; i++)
+		m_lAxis[i] = other.m_lAxis[i];
+	m_lFirst = other.m_lFirst;
+	m_lSecond = other.m_lSecond;
+}
+MyOBBBatch& MyOBBBatch::operator=(MyOBBBatch const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyOBBBatch temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyOBBBatch::~MyOBBBatch() { Release(); };
+//Accessors
+uint MyOBBBatch::GetCount(void) { return m_lCenter[0].size(); }
+//--- Non Standard Singleton Methods
+uint MyOBBBatch::Add(MyRigidBody* a_pRigidBody)
+{
+	//the rigid body already has its box in global space
+	vector3 v3Center = a_pRigidBody->GetCenterGlobal();
+	vector3 v3HalfWidth = a_pRigidBody->GetHalfWidthGlobal();
+	for (uint i = 0; i < 3; i++)
+	{
+		vector3 v3Axis = a_pRigidBody->GetAxisGlobal(i);
+		m_lCenter[i].push_back(v3Center[i]);
+		m_lHalfWidth[i].push_back(v3HalfWidth[i]);
+		for (uint j = 0; j < 3; j++)
+			m_lAxis[i * 3 + j].push_back(v3Axis[j]);
+	}
+	return m_lCenter[0].size() - 1;
+}
+void MyOBBBatch::Clear(void)
+{
+	for (uint i = 0; i < 3; i++)
+	{
+		m_lCenter[i].clear();
+		m_lHalfWidth[i].clear();
+	}
+	for (uint i = 0; i < 9; i++)
+		m_lAxis[i].clear();
+	m_lFirst.clear();
+	m_lSecond.clear();
+}
+void MyOBBBatch::SplitPairs(std::vector<BodyPair> const& a_lPairList)
+{
+	uint uCount = a_lPairList.size();
+	m_lFirst.resize(uCount);
+	m_lSecond.resize(uCount);
+	for (uint i = 0; i < uCount; i++)
+	{
+		m_lFirst[i] = a_lPairList[i].first;
+		m_lSecond[i] = a_lPairList[i].second;
+	}
+}
+void MyOBBBatch::GetLists(MyOBBLists& a_Lists)
+{
+	for (uint i = 0; i < 3; i++)
+	{
+		a_Lists.m_pCenter[i] = m_lCenter[i].data();
+		a_Lists.m_pHalfWidth[i] = m_lHalfWidth[i].data();
+	}
+	for (uint i = 0; i < 9; i++)
+		a_Lists.m_pAxis[i] = m_lAxis[i].data();
+}
+void MyOBBBatch::SAT(std::vector<BodyPair> const& a_lPairList, std::vector<uint>& a_lResult)
+{
+	SplitPairs(a_lPairList);
+	uint uCount = a_lPairList.size();
+	a_lResult.resize(uCount);
+	MyOBBLists lists;
+	GetLists(lists);
+
+	//widest lanes first, each path takes what the one before could not fill
+	static bool bAVX2 = HasAVX2();
+	uint uDone = 0;
+	if (bAVX2)
+		uDone += RunSATAVX2(lists, m_lFirst.data() + uDone, m_lSecond.data() + uDone, uCount - uDone, a_lResult.data() + uDone);
+#ifdef MY_SAT_SSE
+	uDone += RunSAT<SSELanes>(lists, m_lFirst.data() + uDone, m_lSecond.data() + uDone, uCount - uDone, a_lResult.data() + uDone);
+#endif
+	RunSAT<ScalarLanes>(lists, m_lFirst.data() + uDone, m_lSecond.data() + uDone, uCount - uDone, a_lResult.data() + uDone);
+}
+void MyOBBBatch::SATScalar(std::vector<BodyPair> const& a_lPairList, std::vector<uint>& a_lResult)
+{
+	SplitPairs(a_lPairList);
+	uint uCount = a_lPairList.size();
+	a_lResult.resize(uCount);
+	MyOBBLists lists;
+	GetLists(lists);
+	RunSAT<ScalarLanes>(lists, m_lFirst.data(), m_lSecond.data(), uCount, a_lResult.data());
+}
+uint MyOBBBatch::CompareWithScalar(uint a_uPairCount, uint a_uSeed)
+{
+	std::mt19937 generator(a_uSeed);
+	std::uniform_real_distribution<float> random(-1.0f, 1.0f);
+
+	//a unit cube placed with a new model matrix for every box, close enough for a good share to touch
+	std::vector<vector3> lCorner;
+	lCorner.push_back(vector3(-0.5f));
+	lCorner.push_back(vector3(0.5f));
+	MyRigidBody rigidBody(lCorner);
+	Clear();
+	uint uBoxCount = a_uPairCount + 1;
+	for (uint i = 0; i < uBoxCount; i++)
+	{
+		vector3 v3Position = vector3(random(generator), random(generator), random(generator)) * 3.0f;
+		vector3 v3Axis = glm::normalize(vector3(random(generator), random(generator), random(generator)) + vector3(0.01f));
+		vector3 v3Scale = vector3(random(generator), random(generator), random(generator)) + vector3(1.25f);
+		rigidBody.SetModelMatrix(glm::translate(v3Position) * glm::rotate(IDENTITY_M4, random(generator) * static_cast<float>(PI), v3Axis) * glm::scale(v3Scale));
+		Add(&rigidBody);
+	}
+
+	std::vector<BodyPair> lPairList;
+	for (uint i = 0; i < a_uPairCount; i++)
+	{
+		uint uFirst = generator() % uBoxCount;
+		uint uSecond = (uFirst + 1 + generator() % (uBoxCount - 1)) % uBoxCount;
+		lPairList.push_back(BodyPair(uFirst, uSecond));
+	}
+
+	std::vector<uint> lResult;
+	std::vector<uint> lScalar;
+	SAT(lPairList, lResult);
+	SATScalar(lPairList, lScalar);
+	uint uMismatch = 0;
+	for (uint i = 0; i < a_uPairCount; i++)
+	{
+		if (lResult[i] != lScalar[i])
+			++uMismatch;
+	}
+	return uMismatch;
+}
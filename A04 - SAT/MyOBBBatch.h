@@ -0,0 +1,141 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYOBBBATCH_H_
+#define __MYOBBBATCH_H_
+
+#include "MyRigidBody.h"
+
+namespace Simplex
+{
+
+typedef std::pair<uint, uint> BodyPair; //pair of indices in the batch
+struct MyOBBLists; //lists of a batch the kernels read (MyOBBBatchKernel.h)
+
+//System Class
+class MyOBBBatch
+{
+	std::vector<float> m_lCenter[3]; //global center of each box, one list per coordinate
+	std::vector<float> m_lAxis[9]; //normalized global axes of each box, axis * 3 + coordinate
+	std::vector<float> m_lHalfWidth[3]; //half width of each box along each of its axes (scaled)
+
+	std::vector<uint> m_lFirst; //first box of each pair being tested
+	std::vector<uint> m_lSecond; //second box of each pair being tested
+
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object
+	*/
+	MyOBBBatch(void);
+	/*
+	USAGE: Copy Constructor
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyOBBBatch(MyOBBBatch const& other);
+	/*
+	USAGE: Copy Assignment Operator
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyOBBBatch& operator=(MyOBBBatch const& other);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyOBBBatch(void);
+	/*
+	USAGE: Changes object contents for other object's
+	ARGUMENTS:
+	- MyOBBBatch& other -> object to swap content from
+	OUTPUT: ---
+	*/
+	void Swap(MyOBBBatch& other);
+	/*
+	USAGE: Adds the oriented bounding box of a rigid body with its current model matrix
+	ARGUMENTS: MyRigidBody* a_pRigidBody -> rigid body to add
+	OUTPUT: index of the box in the batch
+	*/
+	uint Add(MyRigidBody* a_pRigidBody);
+	/*
+	USAGE: Removes all the boxes
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the number of boxes in the batch
+	ARGUMENTS: ---
+	OUTPUT: box count
+	*/
+	uint GetCount(void);
+	/*
+	USAGE: Runs the separating axis test on every pair, 8 pairs at a time with AVX2 (if the processor
+	has it) then 4 at a time with SSE and the rest one at a time
+	ARGUMENTS:
+	- std::vector<BodyPair> const& a_lPairList -> pairs of boxes to test
+	- std::vector<uint>& a_lResult -> out: eSATResults of each pair, SAT_NONE if they collide or
+	the first axis that separates them
+	OUTPUT: ---
+	*/
+	void SAT(std::vector<BodyPair> const& a_lPairList, std::vector<uint>& a_lResult);
+	/*
+	USAGE: Runs the separating axis test on every pair one at a time, the SIMD paths give the same
+	results bit for bit
+	ARGUMENTS:
+	- std::vector<BodyPair> const& a_lPairList -> pairs of boxes to test
+	- std::vector<uint>& a_lResult -> out: eSATResults of each pair
+	OUTPUT: ---
+	*/
+	void SATScalar(std::vector<BodyPair> const& a_lPairList, std::vector<uint>& a_lResult);
+	/*
+	USAGE: Fills the batch with random boxes (rotated and scaled on each axis) and checks SAT against
+	SATScalar on random pairs of them; a count that is not a multiple of 8 or 4 leaves a remainder
+	for the scalar path to finish after the SIMD ones
+	ARGUMENTS:
+	- uint a_uPairCount -> number of pairs to test
+	- uint a_uSeed = 0 -> seed of the random boxes and pairs
+	OUTPUT: number of pairs whose results differ
+	*/
+	uint CompareWithScalar(uint a_uPairCount, uint a_uSeed = 0);
+
+private:
+	/*
+	USAGE: Deallocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Release(void);
+	/*
+	USAGE: Allocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Splits the pairs in two lists of indices so the SIMD paths can load them
+	ARGUMENTS: std::vector<BodyPair> const& a_lPairList -> pairs of boxes to test
+	OUTPUT: ---
+	*/
+	void SplitPairs(std::vector<BodyPair> const& a_lPairList);
+	/*
+	USAGE: Points the lists the kernels read to the ones of the batch
+	ARGUMENTS: MyOBBLists& a_Lists -> out: lists of the batch
+	OUTPUT: ---
+	*/
+	void GetLists(MyOBBLists& a_Lists);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYOBBBATCH_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
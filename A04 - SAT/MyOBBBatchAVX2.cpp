@@ -0,0 +1,50 @@
+#include "MyOBBBatchKernel.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+using namespace Simplex;
+
+#if defined(__AVX2__)
+namespace
+{
+	//eight pairs at a time
+	struct AVX2Lanes
+	{
+		typedef __m256 Float;
+		typedef __m256 Mask;
+		typedef __m256i Result;
+		static const uint m_uWidth = 8;
+
+		static Float Load(float const* a_pList, uint const* a_pIndex)
+		{
+			return _mm256_i32gather_ps(a_pList, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a_pIndex)), 4);
+		}
+		static Float Set(float a_fValue) { return _mm256_set1_ps(a_fValue); }
+		static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float Abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static Mask Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		static Result Zero(void) { return _mm256_setzero_si256(); }
+		static void Mark(Result& a_Result, Mask a_bSeparated, uint a_uAxis)
+		{
+			//only lanes that had no axis yet take this one
+			__m256i free = _mm256_cmpeq_epi32(a_Result, _mm256_setzero_si256());
+			__m256i take = _mm256_and_si256(free, _mm256_castps_si256(a_bSeparated));
+			a_Result = _mm256_or_si256(a_Result, _mm256_and_si256(take, _mm256_set1_epi32(a_uAxis)));
+		}
+		static bool AllMarked(Result a_Result) { return _mm256_movemask_epi8(_mm256_cmpeq_epi32(a_Result, _mm256_setzero_si256())) == 0; }
+		static void Store(uint* a_pOut, Result a_Result) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(a_pOut), a_Result); }
+	};
+}
+uint Simplex::RunSATAVX2(MyOBBLists const& a_Lists, uint const* a_pFirst, uint const* a_pSecond, uint a_uCount, uint* a_pResult)
+{
+	return RunSAT<AVX2Lanes>(a_Lists, a_pFirst, a_pSecond, a_uCount, a_pResult);
+}
+#else
+//built without AVX2 it tests nothing, the other paths take all the pairs
+uint Simplex::RunSATAVX2(MyOBBLists const& a_Lists, uint const* a_pFirst, uint const* a_pSecond, uint a_uCount, uint* a_pResult)
+{
+	return 0;
+}
+#endif
@@ -0,0 +1,147 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYOBBBATCHKERNEL_H_
+#define __MYOBBBATCHKERNEL_H_
+
+/*
+The separating axis test of MyOBBBatch, written once (RunSAT) over a set of lanes. MyOBBBatchAVX2.cpp is
+the only file built with AVX2 and includes this too, so nothing of the project is included here: an
+inline function that file compiled could be the one linked for the whole program and run on a processor
+without AVX2.
+Every path does the same operations in the same order so they all give the same bits, and the files that
+include this are not allowed to fuse a multiply and an add.
+*/
+#include <cfloat>
+
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace Simplex
+{
+
+typedef unsigned int uint;
+
+//the first axis of each group, the same numbers as eSATResults (MyOBBBatch.cpp checks they still are)
+enum eSATKernelAxis
+{
+	SAT_KERNEL_AX = 1,
+	SAT_KERNEL_BX = 4,
+	SAT_KERNEL_AXxBX = 7,
+};
+
+//the lists of a batch the kernels read, one per coordinate
+struct MyOBBLists
+{
+	float const* m_pCenter[3]; //global center of each box
+	float const* m_pAxis[9]; //normalized global axes of each box, axis * 3 + coordinate
+	float const* m_pHalfWidth[3]; //half width of each box along each of its axes
+};
+
+/*
+USAGE: Runs the test 8 pairs at a time with AVX2, it is in its own file as only that file is built with
+AVX2; call it only if the processor has it
+ARGUMENTS:
+- MyOBBLists const& a_Lists -> boxes of the batch
+- uint const* a_pFirst -> first box of each pair
+- uint const* a_pSecond -> second box of each pair
+- uint a_uCount -> number of pairs
+- uint* a_pResult -> out: eSATResults of each pair tested
+OUTPUT: number of pairs tested, a multiple of 8 (none if the file was built without AVX2)
+*/
+uint RunSATAVX2(MyOBBLists const& a_Lists, uint const* a_pFirst, uint const* a_pSecond, uint a_uCount, uint* a_pResult);
+
+namespace
+{
+	/*
+	Tests as many pairs as fill whole lanes, same 15 axes in the same order as MyRigidBody::SAT,
+	returns how many pairs it tested
+	*/
+	template <class Lanes>
+	uint RunSAT(MyOBBLists const& a_Lists, uint const* a_pFirst, uint const* a_pSecond, uint a_uCount, uint* a_pResult)
+	{
+		typedef typename Lanes::Float Float;
+		typedef typename Lanes::Result Result;
+
+		uint uPair = 0;
+		for (; uPair + Lanes::m_uWidth <= a_uCount; uPair += Lanes::m_uWidth)
+		{
+			uint const* pA = a_pFirst + uPair;
+			uint const* pB = a_pSecond + uPair;
+
+			//gather both boxes
+			Float a[3], b[3], A[3][3], B[3][3], t[3];
+			for (uint i = 0; i < 3; i++)
+			{
+				a[i] = Lanes::Load(a_Lists.m_pHalfWidth[i], pA);
+				b[i] = Lanes::Load(a_Lists.m_pHalfWidth[i], pB);
+				t[i] = Lanes::Sub(Lanes::Load(a_Lists.m_pCenter[i], pB), Lanes::Load(a_Lists.m_pCenter[i], pA));
+				for (uint j = 0; j < 3; j++)
+				{
+					A[i][j] = Lanes::Load(a_Lists.m_pAxis[i * 3 + j], pA);
+					B[i][j] = Lanes::Load(a_Lists.m_pAxis[i * 3 + j], pB);
+				}
+			}
+
+			//translation in the frame of the first box
+			Float tA[3];
+			for (uint i = 0; i < 3; i++)
+				tA[i] = Lanes::Add(Lanes::Add(Lanes::Mul(t[0], A[i][0]), Lanes::Mul(t[1], A[i][1])), Lanes::Mul(t[2], A[i][2]));
+
+			//rotation of the second box in the frame of the first one
+			Float R[3][3], AbsR[3][3];
+			Float fEpsilon = Lanes::Set(FLT_EPSILON);
+			for (uint i = 0; i < 3; i++)
+				for (uint j = 0; j < 3; j++)
+				{
+					R[i][j] = Lanes::Add(Lanes::Add(Lanes::Mul(A[i][0], B[j][0]), Lanes::Mul(A[i][1], B[j][1])), Lanes::Mul(A[i][2], B[j][2]));
+					AbsR[i][j] = Lanes::Add(Lanes::Abs(R[i][j]), fEpsilon);
+				}
+
+			Result result = Lanes::Zero();
+			for (uint i = 0; i < 3; i++)
+			{
+				Float fRadiusA = Lanes::Add(Lanes::Add(Lanes::Mul(a[0], AbsR[0][i]), Lanes::Mul(a[1], AbsR[1][i])), Lanes::Mul(a[2], AbsR[2][i]));
+				Float fProjection = Lanes::Add(Lanes::Add(Lanes::Mul(tA[0], R[0][i]), Lanes::Mul(tA[1], R[1][i])), Lanes::Mul(tA[2], R[2][i]));
+				Lanes::Mark(result, Lanes::Greater(Lanes::Abs(fProjection), Lanes::Add(fRadiusA, b[i])), SAT_KERNEL_AX + i);
+			}
+			for (uint i = 0; i < 3; i++)
+			{
+				Float fRadiusB = Lanes::Add(Lanes::Add(Lanes::Mul(b[0], AbsR[i][0]), Lanes::Mul(b[1], AbsR[i][1])), Lanes::Mul(b[2], AbsR[i][2]));
+				Lanes::Mark(result, Lanes::Greater(Lanes::Abs(tA[i]), Lanes::Add(a[i], fRadiusB)), SAT_KERNEL_BX + i);
+			}
+
+			//the cross products are only needed if some pair is not separated yet
+			if (!Lanes::AllMarked(result))
+			{
+				for (uint i = 0; i < 3; i++)
+				{
+					uint i1 = (i + 1) % 3;
+					uint i2 = (i + 2) % 3;
+					for (uint j = 0; j < 3; j++)
+					{
+						uint j1 = (j + 1) % 3;
+						uint j2 = (j + 2) % 3;
+						Float fRadiusA = Lanes::Add(Lanes::Mul(a[i1], AbsR[i2][j]), Lanes::Mul(a[i2], AbsR[i1][j]));
+						Float fRadiusB = Lanes::Add(Lanes::Mul(b[j1], AbsR[i][j2]), Lanes::Mul(b[j2], AbsR[i][j1]));
+						Float fProjection = Lanes::Sub(Lanes::Mul(tA[i2], R[i1][j]), Lanes::Mul(tA[i1], R[i2][j]));
+						Lanes::Mark(result, Lanes::Greater(Lanes::Abs(fProjection), Lanes::Add(fRadiusA, fRadiusB)), SAT_KERNEL_AXxBX + i * 3 + j);
+					}
+				}
+			}
+
+			Lanes::Store(a_pResult + uPair, result);
+		}
+		return uPair;
+	}
+}
+
+} //namespace Simplex
+
+#endif //__MYOBBBATCHKERNEL_H_
@@ -1,5 +1,6 @@
 #include "MyRigidBody.h"
 using namespace Simplex;
+std::map<String, MyBVFit> MyRigidBody::m_FitMap;
 //Allocation
 void MyRigidBody::Init(void)
 {
@@ -9,6 +10,8 @@ void MyRigidBody::Init(void)
 	m_bVisibleARBB = false;
 
 	m_fRadius = 0.0f;
+	m_v3SphereCenterL = ZERO_V3;
+	m_nFit = BV_FIT_AABB;
 
 	m_v3ColorColliding = C_RED;
 	m_v3ColorNotColliding = C_WHITE;
@@ -21,9 +24,20 @@ void MyRigidBody::Init(void)
 	m_v3MaxG = ZERO_V3;
 
 	m_v3HalfWidth = ZERO_V3;
+	m_v3AxisL[0] = AXIS_X;
+	m_v3AxisL[1] = AXIS_Y;
+	m_v3AxisL[2] = AXIS_Z;
 	m_v3ARBBSize = ZERO_V3;
 
 	m_m4ToWorld = IDENTITY_M4;
+
+	m_v3CenterG = ZERO_V3;
+	m_v3AxisG[0] = AXIS_X;
+	m_v3AxisG[1] = AXIS_Y;
+	m_v3AxisG[2] = AXIS_Z;
+	m_v3HalfWidthG = ZERO_V3;
+	m_v3SphereCenterG = ZERO_V3;
+	m_fRadiusG = 0.0f;
 }
 void MyRigidBody::Swap(MyRigidBody& a_pOther)
 {
@@ -33,6 +47,8 @@ void MyRigidBody::Swap(MyRigidBody& a_pOther)
 	std::swap(m_bVisibleARBB, a_pOther.m_bVisibleARBB);
 
 	std::swap(m_fRadius, a_pOther.m_fRadius);
+	std::swap(m_v3SphereCenterL, a_pOther.m_v3SphereCenterL);
+	std::swap(m_nFit, a_pOther.m_nFit);
 
 	std::swap(m_v3ColorColliding, a_pOther.m_v3ColorColliding);
 	std::swap(m_v3ColorNotColliding, a_pOther.m_v3ColorNotColliding);
@@ -45,10 +61,19 @@ void MyRigidBody::Swap(MyRigidBody& a_pOther)
 	std::swap(m_v3MaxG, a_pOther.m_v3MaxG);
 
 	std::swap(m_v3HalfWidth, a_pOther.m_v3HalfWidth);
+	for (uint i = 0; i < 3; ++i)
+		std::swap(m_v3AxisL[i], a_pOther.m_v3AxisL[i]);
 	std::swap(m_v3ARBBSize, a_pOther.m_v3ARBBSize);
 
 	std::swap(m_m4ToWorld, a_pOther.m_m4ToWorld);
 
+	std::swap(m_v3CenterG, a_pOther.m_v3CenterG);
+	for (uint i = 0; i < 3; ++i)
+		std::swap(m_v3AxisG[i], a_pOther.m_v3AxisG[i]);
+	std::swap(m_v3HalfWidthG, a_pOther.m_v3HalfWidthG);
+	std::swap(m_v3SphereCenterG, a_pOther.m_v3SphereCenterG);
+	std::swap(m_fRadiusG, a_pOther.m_fRadiusG);
+
 	std::swap(m_CollidingRBSet, a_pOther.m_CollidingRBSet);
 }
 void MyRigidBody::Release(void)
@@ -71,7 +96,9 @@ void MyRigidBody::SetColorNotColliding(vector3 a_v3Color) { m_v3ColorNotCollidin
 vector3 MyRigidBody::GetCenterLocal(void) { return m_v3Center; }
 vector3 MyRigidBody::GetMinLocal(void) { return m_v3MinL; }
 vector3 MyRigidBody::GetMaxLocal(void) { return m_v3MaxL; }
-vector3 MyRigidBody::GetCenterGlobal(void){	return vector3(m_m4ToWorld * vector4(m_v3Center, 1.0f)); }
+vector3 MyRigidBody::GetCenterGlobal(void){	return m_v3CenterG; }
+vector3 MyRigidBody::GetAxisGlobal(uint a_uAxis) { return m_v3AxisG[a_uAxis]; }
+vector3 MyRigidBody::GetHalfWidthGlobal(void) { return m_v3HalfWidthG; }
 vector3 MyRigidBody::GetMinGlobal(void) { return m_v3MinG; }
 vector3 MyRigidBody::GetMaxGlobal(void) { return m_v3MaxG; }
 vector3 MyRigidBody::GetHalfWidth(void) { return m_v3HalfWidth; }
@@ -84,6 +111,7 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 
 	//Assign the model matrix
 	m_m4ToWorld = a_m4ModelMatrix;
+	UpdateGlobalOBB();
 
 	//Calculate the 8 corners of the cube
 	vector3 v3Corner[8];
@@ -124,8 +152,37 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 	//we calculate the distance between min and max vectors
 	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 }
+void MyRigidBody::UpdateGlobalOBB(void)
+{
+	m_v3CenterG = vector3(m_m4ToWorld * vector4(m_v3Center, 1.0f));
+	m_v3SphereCenterG = vector3(m_m4ToWorld * vector4(m_v3SphereCenterL, 1.0f));
+
+	//the local axes taken to global space, their length is the scale along them
+	matrix3 m3ToWorld = matrix3(m_m4ToWorld);
+	for (uint i = 0; i < 3; ++i)
+	{
+		vector3 v3Axis = m3ToWorld * m_v3AxisL[i];
+		float fScale = glm::length(v3Axis);
+		if (fScale > 0.0f)
+			m_v3AxisG[i] = v3Axis / fScale;
+		else
+			m_v3AxisG[i] = m_v3AxisL[i];
+		m_v3HalfWidthG[i] = m_v3HalfWidth[i] * fScale;
+	}
+
+	//the sphere around the box reaches its corners, a fitted sphere grows with the largest scale of the model matrix
+	if (m_nFit == BV_FIT_TIGHT)
+	{
+		float fMaxScale = 0.0f;
+		for (uint i = 0; i < 3; ++i)
+			fMaxScale = glm::max(fMaxScale, glm::length(vector3(m_m4ToWorld[i])));
+		m_fRadiusG = m_fRadius * fMaxScale;
+	}
+	else
+		m_fRadiusG = glm::length(m_v3HalfWidthG);
+}
 //The big 3
-MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
+MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList, eBVFit a_nFit, String a_sName)
 {
 	Init();
 	//Count the points of the incoming list
@@ -156,13 +213,198 @@ MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 	m_v3MaxG = m_v3MaxL;
 
 	//with the max and the min we calculate the center
-	m_v3Center = (m_v3MaxL + m_v3MinL) / 2.0f;
+	MyBVFit fit;
+	fit.m_v3Center = (m_v3MaxL + m_v3MinL) / 2.0f;
 
 	//we calculate the distance between min and max vectors
-	m_v3HalfWidth = (m_v3MaxL - m_v3MinL) / 2.0f;
+	fit.m_v3HalfWidth = (m_v3MaxL - m_v3MinL) / 2.0f;
 
 	//Get the distance between the center and either the min or the max
-	m_fRadius = glm::distance(m_v3Center, m_v3MinL);
+	fit.m_v3SphereCenter = fit.m_v3Center;
+	fit.m_fRadius = glm::distance(fit.m_v3Center, m_v3MinL);
+
+	if (a_nFit == BV_FIT_TIGHT)
+	{
+		//a model is fitted only once, the rigid bodies made for it after that share the result
+		std::map<String, MyBVFit>::iterator it = m_FitMap.find(a_sName);
+		if (a_sName != "" && it != m_FitMap.end())
+		{
+			fit = it->second;
+		}
+		else
+		{
+			FitPrincipalAxes(a_pointList, fit);
+			fit.m_v3SphereCenter = fit.m_v3Center;
+			fit.m_fRadius = glm::length(fit.m_v3HalfWidth);
+			FitSphere(a_pointList, fit);
+			if (a_sName != "")
+				m_FitMap[a_sName] = fit;
+		}
+	}
+
+	m_v3Center = fit.m_v3Center;
+	for (uint i = 0; i < 3; ++i)
+		m_v3AxisL[i] = fit.m_v3Axis[i];
+	m_v3HalfWidth = fit.m_v3HalfWidth;
+	m_v3SphereCenterL = fit.m_v3SphereCenter;
+	m_fRadius = fit.m_fRadius;
+	m_nFit = a_nFit;
+
+	UpdateGlobalOBB();
+}
+void MyRigidBody::FitPrincipalAxes(std::vector<vector3> const& a_lPointList, MyBVFit& a_Fit)
+{
+	uint uCount = a_lPointList.size();
+	if (uCount < 2)
+		return;
+
+	//covariance of the points around their mean
+	vector3 v3Mean = ZERO_V3;
+	for (uint i = 0; i < uCount; ++i)
+		v3Mean += a_lPointList[i];
+	v3Mean /= static_cast<float>(uCount);
+
+	float fCovariance[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+	for (uint i = 0; i < uCount; ++i)
+	{
+		vector3 v3Offset = a_lPointList[i] - v3Mean;
+		for (uint j = 0; j < 3; ++j)
+			for (uint k = 0; k < 3; ++k)
+				fCovariance[j][k] += v3Offset[j] * v3Offset[k];
+	}
+
+	//Jacobi rotations until the covariance is diagonal, the rotations together have the eigenvectors as columns
+	float fEigen[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+	uint uPair[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+	for (uint uSweep = 0; uSweep < 32; ++uSweep)
+	{
+		float fOff = glm::abs(fCovariance[0][1]) + glm::abs(fCovariance[0][2]) + glm::abs(fCovariance[1][2]);
+		float fDiagonal = glm::abs(fCovariance[0][0]) + glm::abs(fCovariance[1][1]) + glm::abs(fCovariance[2][2]);
+		if (fOff <= fDiagonal * 0.000001f)
+			break;
+
+		for (uint uRotation = 0; uRotation < 3; ++uRotation)
+		{
+			uint p = uPair[uRotation][0];
+			uint q = uPair[uRotation][1];
+			if (fCovariance[p][q] == 0.0f)
+				continue;
+
+			//the angle that zeroes the element p q
+			float fTheta = (fCovariance[q][q] - fCovariance[p][p]) / (2.0f * fCovariance[p][q]);
+			float fTangent = 1.0f / (glm::abs(fTheta) + glm::sqrt(fTheta * fTheta + 1.0f));
+			if (fTheta < 0.0f)
+				fTangent = -fTangent;
+			float fCos = 1.0f / glm::sqrt(fTangent * fTangent + 1.0f);
+			float fSin = fTangent * fCos;
+
+			for (uint k = 0; k < 3; ++k)
+			{
+				float fP = fCovariance[k][p];
+				float fQ = fCovariance[k][q];
+				fCovariance[k][p] = fCos * fP - fSin * fQ;
+				fCovariance[k][q] = fSin * fP + fCos * fQ;
+			}
+			for (uint k = 0; k < 3; ++k)
+			{
+				float fP = fCovariance[p][k];
+				float fQ = fCovariance[q][k];
+				fCovariance[p][k] = fCos * fP - fSin * fQ;
+				fCovariance[q][k] = fSin * fP + fCos * fQ;
+			}
+			for (uint k = 0; k < 3; ++k)
+			{
+				float fP = fEigen[k][p];
+				float fQ = fEigen[k][q];
+				fEigen[k][p] = fCos * fP - fSin * fQ;
+				fEigen[k][q] = fSin * fP + fCos * fQ;
+			}
+		}
+	}
+
+	//right handed so the box can be drawn with the axes as a rotation
+	vector3 v3Axis[3];
+	v3Axis[0] = glm::normalize(vector3(fEigen[0][0], fEigen[1][0], fEigen[2][0]));
+	v3Axis[1] = glm::normalize(vector3(fEigen[0][1], fEigen[1][1], fEigen[2][1]));
+	v3Axis[2] = glm::cross(v3Axis[0], v3Axis[1]);
+
+	//extent of the points along each axis
+	vector3 v3Min = vector3(FLT_MAX);
+	vector3 v3Max = vector3(-FLT_MAX);
+	for (uint i = 0; i < uCount; ++i)
+	{
+		for (uint k = 0; k < 3; ++k)
+		{
+			float fProjection = glm::dot(a_lPointList[i], v3Axis[k]);
+			v3Min[k] = glm::min(v3Min[k], fProjection);
+			v3Max[k] = glm::max(v3Max[k], fProjection);
+		}
+	}
+
+	//blocky models are often tighter along their own axes, keep whichever box is smaller
+	vector3 v3HalfWidth = (v3Max - v3Min) / 2.0f;
+	float fVolume = v3HalfWidth.x * v3HalfWidth.y * v3HalfWidth.z;
+	float fVolumeAABB = a_Fit.m_v3HalfWidth.x * a_Fit.m_v3HalfWidth.y * a_Fit.m_v3HalfWidth.z;
+	if (fVolume >= fVolumeAABB * 0.99f)
+		return;
+
+	a_Fit.m_v3Center = ZERO_V3;
+	for (uint k = 0; k < 3; ++k)
+	{
+		a_Fit.m_v3Center += v3Axis[k] * ((v3Min[k] + v3Max[k]) / 2.0f);
+		a_Fit.m_v3Axis[k] = v3Axis[k];
+	}
+	a_Fit.m_v3HalfWidth = v3HalfWidth;
+}
+void MyRigidBody::FitSphere(std::vector<vector3> const& a_lPointList, MyBVFit& a_Fit)
+{
+	uint uCount = a_lPointList.size();
+	if (uCount < 2)
+		return;
+
+	//the point furthest from the first one, and the point furthest from that one
+	uint uA = 0;
+	uint uB = 0;
+	float fFar = 0.0f;
+	for (uint i = 1; i < uCount; ++i)
+	{
+		float fDistance = glm::distance(a_lPointList[i], a_lPointList[0]);
+		if (fDistance > fFar)
+		{
+			fFar = fDistance;
+			uA = i;
+		}
+	}
+	fFar = 0.0f;
+	for (uint i = 0; i < uCount; ++i)
+	{
+		float fDistance = glm::distance(a_lPointList[i], a_lPointList[uA]);
+		if (fDistance > fFar)
+		{
+			fFar = fDistance;
+			uB = i;
+		}
+	}
+
+	//start with them as the diameter and grow it just enough to reach every point left out
+	vector3 v3Center = (a_lPointList[uA] + a_lPointList[uB]) / 2.0f;
+	float fRadius = fFar / 2.0f;
+	for (uint i = 0; i < uCount; ++i)
+	{
+		float fDistance = glm::distance(a_lPointList[i], v3Center);
+		if (fDistance > fRadius)
+		{
+			float fNewRadius = (fRadius + fDistance) / 2.0f;
+			v3Center += (a_lPointList[i] - v3Center) * ((fNewRadius - fRadius) / fDistance);
+			fRadius = fNewRadius;
+		}
+	}
+
+	if (fRadius < a_Fit.m_fRadius)
+	{
+		a_Fit.m_v3SphereCenter = v3Center;
+		a_Fit.m_fRadius = fRadius;
+	}
 }
 MyRigidBody::MyRigidBody(MyRigidBody const& a_pOther)
 {
@@ -173,6 +415,8 @@ MyRigidBody::MyRigidBody(MyRigidBody const& a_pOther)
 	m_bVisibleARBB = a_pOther.m_bVisibleARBB;
 
 	m_fRadius = a_pOther.m_fRadius;
+	m_v3SphereCenterL = a_pOther.m_v3SphereCenterL;
+	m_nFit = a_pOther.m_nFit;
 
 	m_v3ColorColliding = a_pOther.m_v3ColorColliding;
 	m_v3ColorNotColliding = a_pOther.m_v3ColorNotColliding;
@@ -185,10 +429,19 @@ MyRigidBody::MyRigidBody(MyRigidBody const& a_pOther)
 	m_v3MaxG = a_pOther.m_v3MaxG;
 
 	m_v3HalfWidth = a_pOther.m_v3HalfWidth;
+	for (uint i = 0; i < 3; ++i)
+		m_v3AxisL[i] = a_pOther.m_v3AxisL[i];
 	m_v3ARBBSize = a_pOther.m_v3ARBBSize;
 
 	m_m4ToWorld = a_pOther.m_m4ToWorld;
 
+	m_v3CenterG = a_pOther.m_v3CenterG;
+	for (uint i = 0; i < 3; ++i)
+		m_v3AxisG[i] = a_pOther.m_v3AxisG[i];
+	m_v3HalfWidthG = a_pOther.m_v3HalfWidthG;
+	m_v3SphereCenterG = a_pOther.m_v3SphereCenterG;
+	m_fRadiusG = a_pOther.m_fRadiusG;
+
 	m_CollidingRBSet = a_pOther.m_CollidingRBSet;
 }
 MyRigidBody& MyRigidBody::operator=(MyRigidBody const& a_pOther)
@@ -226,8 +479,10 @@ void MyRigidBody::ClearCollidingList(void)
 }
 bool MyRigidBody::IsColliding(MyRigidBody* const a_pOther)
 {
-	//check if spheres are colliding as pre-test
-	bool bColliding = (glm::distance(GetCenterGlobal(), a_pOther->GetCenterGlobal()) < m_fRadius + a_pOther->m_fRadius);
+	//check if spheres are colliding as pre-test, squared so there is no root
+	vector3 v3Distance = a_pOther->m_v3SphereCenterG - m_v3SphereCenterG;
+	float fRadii = m_fRadiusG + a_pOther->m_fRadiusG;
+	bool bColliding = glm::dot(v3Distance, v3Distance) < fRadii * fRadii;
 	
 	//if they are colliding check the SAT
 	if (bColliding)
@@ -254,16 +509,18 @@ void MyRigidBody::AddToRenderList(void)
 	if (m_bVisibleBS)
 	{
 		if (m_CollidingRBSet.size() > 0)
-			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3Center) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
+			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3SphereCenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 		else
-			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3Center) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
+			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3SphereCenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 	}
 	if (m_bVisibleOBB)
 	{
+		//the box can be turned in local space when it is fitted to the principal axes
+		matrix4 m4Orientation = matrix4(matrix3(m_v3AxisL[0], m_v3AxisL[1], m_v3AxisL[2]));
 		if (m_CollidingRBSet.size() > 0)
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3Center) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorColliding);
+			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3Center) * m4Orientation * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorColliding);
 		else
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3Center) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorNotColliding);
+			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3Center) * m4Orientation * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorNotColliding);
 	}
 	if (m_bVisibleARBB)
 	{
@@ -287,44 +544,19 @@ uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
 	(eSATResults::SAT_NONE has a value of 0)
 	*/
 
-	//get the radius of this object
-	float thisRadius = this->GetRadius();
-
-	//get the radius of the other object
-	float otherRadius = a_pOther->GetRadius();
+	//everything comes from the global box calculated with the model matrix
+	float thisRadius = 0.0f;
+	float otherRadius = 0.0f;
 
-	//create rotaion 3x3 mats for this object
+	//rotation of the other object in this object's frame, and its absolute value
 	glm::mat3x3 thisRotation;
-
-	//create rotation 3x3 mats for other object
 	glm::mat3x3 otherRotation;
 
-	//this object's center
-	vector3 thisCenter = this->GetCenterGlobal();
-
-	//other object's center
-	vector3 otherCenter = a_pOther->GetCenterGlobal();
-
-	//this objects' halfwidth
-	vector3 thisHalfW = this->GetHalfWidth();
-
-	//other ojects' halfwidth
-	vector3 otherHalfW = a_pOther->GetHalfWidth();
-
-	//create and fill vec with this objecets' model matrix points
-	std::vector<vector3> thisVecPoints;
-
-	thisVecPoints.push_back(vector3(this->GetModelMatrix()[0][0], this->GetModelMatrix()[0][1], this->GetModelMatrix()[0][2]));
-	thisVecPoints.push_back(vector3(this->GetModelMatrix()[1][0], this->GetModelMatrix()[1][1], this->GetModelMatrix()[1][2]));
-	thisVecPoints.push_back(vector3(this->GetModelMatrix()[2][0], this->GetModelMatrix()[2][1], this->GetModelMatrix()[2][2]));
-
-	//create and fill vec with the other objecets' model matrix points
-	std::vector<vector3> otherVecPoints;
-
-	otherVecPoints.push_back(vector3(a_pOther->GetModelMatrix()[0][0], a_pOther->GetModelMatrix()[0][1], a_pOther->GetModelMatrix()[0][2]));
-	otherVecPoints.push_back(vector3(a_pOther->GetModelMatrix()[1][0], a_pOther->GetModelMatrix()[1][1], a_pOther->GetModelMatrix()[1][2]));
-	otherVecPoints.push_back(vector3(a_pOther->GetModelMatrix()[2][0], a_pOther->GetModelMatrix()[2][1], a_pOther->GetModelMatrix()[2][2]));
+	vector3 thisHalfW = m_v3HalfWidthG;
+	vector3 otherHalfW = a_pOther->m_v3HalfWidthG;
 
+	vector3 const* thisVecPoints = m_v3AxisG;
+	vector3 const* otherVecPoints = a_pOther->m_v3AxisG;
 
 	// Calculate the rotation matrix of other object in this objects' frame
 	for (int i = 0; i < 3; i++)
@@ -332,7 +564,7 @@ uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
 			thisRotation[i][j] = glm::dot(thisVecPoints[i], otherVecPoints[j]);
 
 	// Calculate the translation vector
-	vector3 t = a_pOther->GetCenterGlobal() - this->GetCenterGlobal();
+	vector3 t = a_pOther->m_v3CenterG - m_v3CenterG;
 
 	// move translation vector to match this objects' frame
 	t = vector3(glm::dot(t, thisVecPoints[0]), glm::dot(t, thisVecPoints[1]), glm::dot(t, thisVecPoints[2]));
@@ -10,6 +10,23 @@ Date: 2017/06
 namespace Simplex
 {
 
+//How the rigid body fits its bounding volumes to the points
+enum eBVFit
+{
+	BV_FIT_AABB = 0, //the box is the axis aligned box in local space and the sphere goes around it
+	BV_FIT_TIGHT = 1, //the box uses the principal axes of the points if it is smaller that way and the sphere hugs the points
+};
+
+//Bounding volumes fitted to a list of points, in local space
+struct MyBVFit
+{
+	vector3 m_v3Center = ZERO_V3; //center of the box
+	vector3 m_v3Axis[3] = { AXIS_X, AXIS_Y, AXIS_Z }; //normalized axes of the box
+	vector3 m_v3HalfWidth = ZERO_V3; //half the size of the box along its axes
+	vector3 m_v3SphereCenter = ZERO_V3; //center of the sphere
+	float m_fRadius = 0.0f; //radius of the sphere
+};
+
 //System Class
 class MyRigidBody
 {
@@ -20,6 +37,8 @@ class MyRigidBody
 	bool m_bVisibleARBB = true; //Visibility of axis (Re)aligned bounding box
 
 	float m_fRadius = 0.0f; //Radius
+	vector3 m_v3SphereCenterL = ZERO_V3; //center of the bounding sphere in local space, not always the center of the box
+	eBVFit m_nFit = BV_FIT_AABB; //how the box and the sphere were fitted to the points
 
 	vector3 m_v3ColorColliding = C_RED; //Color when colliding
 	vector3 m_v3ColorNotColliding = C_WHITE; //Color when not colliding
@@ -32,19 +51,31 @@ class MyRigidBody
 	vector3 m_v3MaxG = ZERO_V3; //maximum coordinate in global space (for ARBB)
 
 	vector3 m_v3HalfWidth = ZERO_V3; //half the size of the Oriented Bounding Box
+	vector3 m_v3AxisL[3]; //normalized axes of the Oriented Bounding Box in local space
 	vector3 m_v3ARBBSize = ZERO_V3;// size of the Axis (Re)Alligned Bounding Box
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Matrix that will take us from local to world coordinate
 
+	vector3 m_v3CenterG = ZERO_V3; //center point in global space, updated with the model matrix
+	vector3 m_v3AxisG[3]; //normalized axes of the Oriented Bounding Box in global space
+	vector3 m_v3HalfWidthG = ZERO_V3; //half width scaled by the model matrix, along the global axes
+	vector3 m_v3SphereCenterG = ZERO_V3; //center of the bounding sphere in global space
+	float m_fRadiusG = 0.0f; //radius scaled by the model matrix
+
+	static std::map<String, MyBVFit> m_FitMap; //volumes already fitted, by name of the model
+
 	std::set<MyRigidBody*> m_CollidingRBSet; //set of rigid bodies this one is colliding with
 
 public:
 	/*
 	Usage: Constructor
-	Arguments: std::vector<vector3> a_pointList -> list of points to make the Rigid Body for
+	Arguments:
+	-	std::vector<vector3> a_pointList -> list of points to make the Rigid Body for
+	-	eBVFit a_nFit = BV_FIT_AABB -> how to fit the box and the sphere to the points
+	-	String a_sName = "" -> name of the model the points come from, the fit is done once per name
 	Output: class object instance
 	*/
-	MyRigidBody(std::vector<vector3> a_pointList);
+	MyRigidBody(std::vector<vector3> a_pointList, eBVFit a_nFit = BV_FIT_AABB, String a_sName = "");
 	/*
 	Usage: Copy Constructor
 	Arguments: class object to copy
@@ -196,6 +227,18 @@ public:
 	*/
 	vector3 GetCenterGlobal(void);
 	/*
+	Usage: Gets one of the normalized axes of the Oriented Bounding Box in global space
+	Arguments: uint a_uAxis -> 0 for x, 1 for y, 2 for z
+	Output: axis
+	*/
+	vector3 GetAxisGlobal(uint a_uAxis);
+	/*
+	Usage: Gets the half width scaled by the model matrix, along the axes in global space
+	Arguments: ---
+	Output: halfwidth vector
+	*/
+	vector3 GetHalfWidthGlobal(void);
+	/*
 	Usage: Gets minimum vector in local space
 	Arguments: ---
 	Output: min vector
@@ -241,6 +284,31 @@ private:
 	*/
 	void Init(void);
 	/*
+	USAGE: Calculates the center, axes, half width and radius in global space from the model matrix
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateGlobalOBB(void);
+	/*
+	USAGE: Fits the box to the principal axes of the points, from the eigenvectors of their covariance,
+	and keeps it only if it is smaller than the box along the local axes
+	ARGUMENTS:
+	-	std::vector<vector3> const& a_lPointList -> points to fit
+	-	MyBVFit& a_Fit -> in: box along the local axes, out: smallest box
+	OUTPUT: ---
+	*/
+	static void FitPrincipalAxes(std::vector<vector3> const& a_lPointList, MyBVFit& a_Fit);
+	/*
+	USAGE: Fits a sphere to the points with Ritter's method, starting from the two points furthest apart
+	along one direction and growing it for the points left out, and keeps it only if it is smaller than
+	the sphere around the box
+	ARGUMENTS:
+	-	std::vector<vector3> const& a_lPointList -> points to fit
+	-	MyBVFit& a_Fit -> in: sphere around the box, out: smallest sphere
+	OUTPUT: ---
+	*/
+	static void FitSphere(std::vector<vector3> const& a_lPointList, MyBVFit& a_Fit);
+	/*
 	USAGE: This will try to find a Separation Axis, will return 0 if 
 		none found (there is a collision)
 	ARGUMENTS: MyRigidBody* const a_pOther -> other rigid body to test against
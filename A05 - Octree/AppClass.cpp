@@ -30,7 +30,8 @@ void Application::InitVariables(void)
 		}
 	}
 	m_uOctantLevels = 0;
-	m_pRoot = new MyOctant(m_uOctantLevels, 5);
+	m_pRoot = new MyOctant(m_uOctantLevels, 5, m_fOctantLooseness);
+	m_pEntityMngr->SetOctree(m_pRoot);
 	m_pEntityMngr->Update();
 }
 void Application::Update(void)
@@ -56,7 +57,13 @@ void Application::Display(void)
 	ClearScreen();
 
 	//display octree
-	if (m_uOctantID == -1) {
+	if (m_pLinearRoot != nullptr) {
+		if (m_uOctantID == -1)
+			m_pLinearRoot->Display();
+		else
+			m_pLinearRoot->Display(m_uOctantID);
+	}
+	else if (m_uOctantID == -1) {
 		m_pRoot->Display();
 	}
 	else {
@@ -80,6 +87,15 @@ void Application::Display(void)
 }
 void Application::Release(void)
 {
+	//release the octrees
+	m_pEntityMngr->SetOctree(nullptr);
+	m_pEntityMngr->SetLinearOctree(nullptr);
+	SafeDelete(m_pRoot);
+	SafeDelete(m_pLinearRoot);
+
+	//stop the threads the octree used
+	MyThreadPool::ReleaseInstance();
+
 	//release GUI
 	ShutdownGUI();
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ Date: 2017/06
 
 #include "MyEntityManager.h"
 #include "MyOctant.h"
+#include "MyLinearOctree.h"
 
 namespace Simplex
 {
@@ -20,9 +21,11 @@ class Application
 {
 	MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager
 	MyOctant* m_pRoot = nullptr;
+	MyLinearOctree* m_pLinearRoot = nullptr; //linear octree, used instead of the root when not nullptr
 	uint m_uOctantID = -1; //Index of Octant to display
 	uint m_uObjects = 0; //Number of objects in the scene
 	uint m_uOctantLevels = 0; //Number of levels in the octree
+	float m_fOctantLooseness = 1.0f; //loose factor of the octree, 1 is a regular octree
 private:
 	String m_sProgrammer = "Dexter Delandro - dmd7488@rit.edu"; //programmer
 
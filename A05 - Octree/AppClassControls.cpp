@@ -114,14 +114,14 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 	case sf::Keyboard::PageUp:
 		++m_uOctantID;
 		
-		if (m_uOctantID >= m_pRoot->GetOctantCount())
+		if (m_uOctantID >= (m_pLinearRoot != nullptr ? m_pLinearRoot->GetOctantCount() : m_pRoot->GetOctantCount()))
 			m_uOctantID = - 1;
 		
 		break;
 	case sf::Keyboard::PageDown:
 		--m_uOctantID;
 		
-		if (m_uOctantID >= m_pRoot->GetOctantCount())
+		if (m_uOctantID >= (m_pLinearRoot != nullptr ? m_pLinearRoot->GetOctantCount() : m_pRoot->GetOctantCount()))
 			m_uOctantID = - 1;
 		
 		break;
@@ -132,7 +132,14 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 			++m_uOctantLevels;
 			
 			SafeDelete(m_pRoot);
-			m_pRoot = new MyOctant(m_uOctantLevels, 5);
+			m_pRoot = new MyOctant(m_uOctantLevels, 5, m_fOctantLooseness);
+			m_pEntityMngr->SetOctree(m_pRoot);
+			if (m_pLinearRoot != nullptr)
+			{
+				SafeDelete(m_pLinearRoot);
+				m_pLinearRoot = new MyLinearOctree(m_uOctantLevels, 5);
+				m_pEntityMngr->SetLinearOctree(m_pLinearRoot);
+			}
 			
 		}
 		break;
@@ -143,10 +150,43 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 			--m_uOctantLevels;
 			
 			SafeDelete(m_pRoot);
-			m_pRoot = new MyOctant(m_uOctantLevels, 5);
+			m_pRoot = new MyOctant(m_uOctantLevels, 5, m_fOctantLooseness);
+			m_pEntityMngr->SetOctree(m_pRoot);
+			if (m_pLinearRoot != nullptr)
+			{
+				SafeDelete(m_pLinearRoot);
+				m_pLinearRoot = new MyLinearOctree(m_uOctantLevels, 5);
+				m_pEntityMngr->SetLinearOctree(m_pLinearRoot);
+			}
 			
 		}
 		break;
+	case sf::Keyboard::B:
+		m_pEntityMngr->UseSweepAndPrune(!m_pEntityMngr->IsUsingSweepAndPrune());
+		break;
+	case sf::Keyboard::L:
+		//switch between the octree and the linear octree
+		if (m_pLinearRoot == nullptr)
+		{
+			m_pLinearRoot = new MyLinearOctree(m_uOctantLevels, 5);
+		}
+		else
+		{
+			SafeDelete(m_pLinearRoot);
+		}
+		m_pEntityMngr->SetLinearOctree(m_pLinearRoot);
+		m_uOctantID = -1;
+		break;
+	case sf::Keyboard::K:
+		//switch between the octree and the loose octree
+		m_pEntityMngr->ClearDimensionSetAll();
+		m_fOctantLooseness = m_fOctantLooseness > 1.0f ? 1.0f : 2.0f;
+
+		SafeDelete(m_pRoot);
+		m_pRoot = new MyOctant(m_uOctantLevels, 5, m_fOctantLooseness);
+		m_pEntityMngr->SetOctree(m_pRoot);
+		m_uOctantID = -1;
+		break;
 	case sf::Keyboard::LShift:
 	case sf::Keyboard::RShift:
 		m_bModifier = false;
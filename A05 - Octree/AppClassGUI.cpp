@@ -41,6 +41,7 @@ void Application::DrawGUI(void)
 			ImGui::Text("Levels in Octree: %d\n", m_uOctantLevels);
 			//ImGui::Text("Octants: %d\n", m_pRoot->GetOctantCount());
 			ImGui::Text("Objects: %d\n", m_uObjects);
+			ImGui::Text("Pairs checked: %d\n", m_pEntityMngr->GetPairCount());
 			ImGui::Separator();
 			ImGui::Text("Control:\n");
 			ImGui::Text("   WASD: Movement\n");
@@ -54,8 +55,18 @@ void Application::DrawGUI(void)
 			ImGui::Separator();
 			ImGui::Text("	  -: Increment Octree subdivision\n");
 			ImGui::Text("	  +: Decrement Octree subdivision\n");
+			ImGui::Text("	  B: Toggle Sweep and Prune\n");
+			ImGui::Text("	  L: Toggle Linear Octree\n");
+			ImGui::Text("	  K: Toggle Loose Octree\n");
 			ImGui::Separator();
-			ImGui::TextColored(ImColor(255, 255, 0), "Octree\n");
+			if (m_pEntityMngr->IsUsingSweepAndPrune())
+				ImGui::TextColored(ImColor(255, 255, 0), "Sweep and Prune\n");
+			else if (m_pLinearRoot != nullptr)
+				ImGui::TextColored(ImColor(255, 255, 0), "Linear Octree\n");
+			else if (m_pRoot->IsLoose())
+				ImGui::TextColored(ImColor(255, 255, 0), "Loose Octree\n");
+			else
+				ImGui::TextColored(ImColor(255, 255, 0), "Octree\n");
 		}
 		ImGui::End();
 	}
@@ -233,6 +233,25 @@ bool Simplex::MyEntity::SharesDimension(MyEntity* const a_pOther)
 	//could not find a common dimension
 	return false;
 }
+int Simplex::MyEntity::GetFirstSharedDimension(MyEntity* const a_pOther)
+{
+	//both arrays are kept sorted so we can walk them at the same time
+	uint i = 0;
+	uint j = 0;
+	while (i < m_nDimensionCount && j < a_pOther->m_nDimensionCount)
+	{
+		if (m_DimensionArray[i] == a_pOther->m_DimensionArray[j])
+			return static_cast<int>(m_DimensionArray[i]);
+
+		if (m_DimensionArray[i] < a_pOther->m_DimensionArray[j])
+			++i;
+		else
+			++j;
+	}
+
+	//could not find a common dimension
+	return -1;
+}
 bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 {
 	//if not in memory return
@@ -246,6 +265,17 @@ bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 
 	return m_pRigidBody->IsColliding(other->GetRigidBody());
 }
+bool Simplex::MyEntity::IsOverlapping(MyEntity* const a_pOther)
+{
+	//same checks as IsColliding but nothing is marked
+	if (!m_bInMemory || !a_pOther->m_bInMemory)
+		return false;
+
+	if (!SharesDimension(a_pOther))
+		return false;
+
+	return m_pRigidBody->IsOverlapping(a_pOther->GetRigidBody());
+}
 void Simplex::MyEntity::ClearCollisionList(void)
 {
 	m_pRigidBody->ClearCollidingList();
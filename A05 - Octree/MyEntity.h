@@ -104,6 +104,13 @@ public:
 	*/
 	bool IsColliding(MyEntity* const other);
 	/*
+	USAGE: Tells if the collision with the incoming entity needs to be marked, without marking it,
+	entities not in memory or not sharing a dimension never need it
+	ARGUMENTS: MyEntity* const a_pOther -> inspected entity
+	OUTPUT: are they overlapping?
+	*/
+	bool IsOverlapping(MyEntity* const a_pOther);
+	/*
 	USAGE: Gets the MyEntity specified by unique ID, nullptr if not exists
 	ARGUMENTS: String a_sUniqueID -> unique ID if the queried entity
 	OUTPUT: MyEntity specified by unique ID, nullptr if not exists
@@ -157,6 +164,12 @@ public:
 	OUTPUT: shares at least one dimension?
 	*/
 	bool SharesDimension(MyEntity* const a_pOther);
+	/*
+	USAGE: Gets the lowest dimension this entity shares with the incoming one
+	ARGUMENTS: MyEntity* const a_pOther -> queried entity
+	OUTPUT: lowest shared dimension, -1 if they do not share any
+	*/
+	int GetFirstSharedDimension(MyEntity* const a_pOther);
 
 	/*
 	USAGE: Clears the collision list of this entity
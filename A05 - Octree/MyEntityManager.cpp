@@ -1,4 +1,8 @@
 #include "MyEntityManager.h"
+#include "MyOctant.h"
+#include "MySweepAndPrune.h"
+#include "MyLinearOctree.h"
+#include "MyThreadPool.h"
 using namespace Simplex;
 //  MyEntityManager
 Simplex::MyEntityManager* Simplex::MyEntityManager::m_pInstance = nullptr;
@@ -6,9 +10,17 @@ void Simplex::MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
 	m_mEntityArray = nullptr;
+	m_pOctree = nullptr;
+	m_pLinearOctree = nullptr;
+	m_lPairList.clear();
+	m_uPairCount = 0;
+	m_pSweepAndPrune = nullptr;
+	m_lChunkStart.clear();
+	m_lChunkResult.clear();
 }
 void Simplex::MyEntityManager::Release(void)
 {
+	SafeDelete(m_pSweepAndPrune);
 	for (uint uEntity = 0; uEntity < m_uEntityCount; ++uEntity)
 	{
 		MyEntity* pEntity = m_mEntityArray[uEntity];
@@ -46,6 +58,21 @@ int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 }
 //Accessors
 Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_uEntityCount; }
+void Simplex::MyEntityManager::SetOctree(MyOctant* a_pOctree) { m_pOctree = a_pOctree; }
+void Simplex::MyEntityManager::SetLinearOctree(MyLinearOctree* a_pOctree) { m_pLinearOctree = a_pOctree; }
+Simplex::uint Simplex::MyEntityManager::GetPairCount(void) { return m_uPairCount; }
+bool Simplex::MyEntityManager::IsUsingSweepAndPrune(void) { return m_pSweepAndPrune != nullptr; }
+void Simplex::MyEntityManager::UseSweepAndPrune(bool a_bUse)
+{
+	if (a_bUse && m_pSweepAndPrune == nullptr)
+	{
+		m_pSweepAndPrune = new MySweepAndPrune();
+	}
+	else if (!a_bUse)
+	{
+		SafeDelete(m_pSweepAndPrune);
+	}
+}
 Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 {
 	//if the list is empty return
@@ -167,21 +194,132 @@ Simplex::MyEntityManager::~MyEntityManager(){Release();};
 // other methods
 void Simplex::MyEntityManager::Update(void)
 {
+	//sweep and prune keeps the collisions from the last frame and only fixes the ones that changed
+	if (m_pSweepAndPrune != nullptr)
+	{
+		m_pSweepAndPrune->Update();
+		m_uPairCount = m_pSweepAndPrune->GetPairCount();
+		return;
+	}
+
 	//Clear all collisions
 	for (uint i = 0; i < m_uEntityCount; i++)
 	{
 		m_mEntityArray[i]->ClearCollisionList();
 	}
 
+	//without an octree every pair needs to be checked
+	if (m_pOctree == nullptr && m_pLinearOctree == nullptr)
+	{
+		m_uPairCount = m_uEntityCount * (m_uEntityCount - 1) / 2;
+		Narrowphase(true);
+		return;
+	}
+
+	//only the entities that share a leaf of the octree can be colliding
+	m_lPairList.clear();
+	if (m_pLinearOctree != nullptr)
+		m_pLinearOctree->GetCollisionPairs(m_lPairList);
+	else
+	{
+		//the entities that moved since the last update go to their new leafs, the tree is not built again
+		m_pOctree->Refit();
+		m_pOctree->GetCollisionPairs(m_lPairList);
+	}
+	m_uPairCount = m_lPairList.size();
+
 	//check collisions
-	for (uint i = 0; i < m_uEntityCount - 1; i++)
+	Narrowphase(false);
+}
+void Simplex::MyEntityManager::Narrowphase(bool a_bAllPairs)
+{
+	//cut the pairs in chunks of about the same size
+	m_lChunkStart.clear();
+	m_lChunkStart.push_back(0);
+	if (a_bAllPairs)
+	{
+		//every row has one pair less than the one before, the chunks take as many rows as they need
+		uint uPairs = 0;
+		for (uint i = 0; i + 1 < m_uEntityCount; i++)
+		{
+			uPairs += m_uEntityCount - i - 1;
+			if (uPairs >= m_uChunkSize)
+			{
+				m_lChunkStart.push_back(i + 1);
+				uPairs = 0;
+			}
+		}
+		if (m_lChunkStart.back() < m_uEntityCount)
+			m_lChunkStart.push_back(m_uEntityCount);
+	}
+	else
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		for (uint i = m_uChunkSize; i < m_uPairCount; i += m_uChunkSize)
+			m_lChunkStart.push_back(i);
+		m_lChunkStart.push_back(m_uPairCount);
+	}
+	uint uChunkCount = m_lChunkStart.size() - 1;
+	if (m_lChunkResult.size() < uChunkCount)
+		m_lChunkResult.resize(uChunkCount);
+
+	//the chunks only read the entities so they can run at the same time
+	MyThreadPool* pPool = MyThreadPool::GetInstance();
+	if (pPool->GetThreadCount() > 1 && uChunkCount > 1)
+	{
+		for (uint i = 0; i < uChunkCount; i++)
+		{
+			pPool->Run([this, i, a_bAllPairs]() { CheckChunk(i, a_bAllPairs); });
+		}
+		pPool->Wait();
+	}
+	else
+	{
+		for (uint i = 0; i < uChunkCount; i++)
+		{
+			CheckChunk(i, a_bAllPairs);
+		}
+	}
+
+	//mark the collisions in chunk order, the same order a single thread would have found them
+	for (uint i = 0; i < uChunkCount; i++)
+	{
+		std::vector<EntityPair>& lColliding = m_lChunkResult[i];
+		for (uint j = 0; j < lColliding.size(); j++)
 		{
-			m_mEntityArray[i]->IsColliding(m_mEntityArray[j]);
+			MyRigidBody* pRigidBodyA = m_mEntityArray[lColliding[j].first]->GetRigidBody();
+			MyRigidBody* pRigidBodyB = m_mEntityArray[lColliding[j].second]->GetRigidBody();
+			pRigidBodyA->AddCollisionWith(pRigidBodyB);
+			pRigidBodyB->AddCollisionWith(pRigidBodyA);
 		}
 	}
 }
+void Simplex::MyEntityManager::CheckChunk(uint a_uChunk, bool a_bAllPairs)
+{
+	std::vector<EntityPair>& lColliding = m_lChunkResult[a_uChunk];
+	lColliding.clear();
+
+	uint uStart = m_lChunkStart[a_uChunk];
+	uint uEnd = m_lChunkStart[a_uChunk + 1];
+	if (a_bAllPairs)
+	{
+		for (uint i = uStart; i < uEnd; i++)
+		{
+			for (uint j = i + 1; j < m_uEntityCount; j++)
+			{
+				if (m_mEntityArray[i]->IsOverlapping(m_mEntityArray[j]))
+					lColliding.push_back(EntityPair(i, j));
+			}
+		}
+		return;
+	}
+
+	for (uint i = uStart; i < uEnd; i++)
+	{
+		EntityPair const& pair = m_lPairList[i];
+		if (m_mEntityArray[pair.first]->IsOverlapping(m_mEntityArray[pair.second]))
+			lColliding.push_back(pair);
+	}
+}
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
 	//Create a temporal entity to store the object
@@ -10,6 +10,12 @@ Date: 2017/07
 namespace Simplex
 {
 
+class MyOctant; //Octree used as broadphase, defined in MyOctant.h
+class MyLinearOctree; //Octree stored in a flat array, defined in MyLinearOctree.h
+class MySweepAndPrune; //Sorted bounds used as broadphase, defined in MySweepAndPrune.h
+
+typedef std::pair<uint, uint> EntityPair; //pair of indices in the Entity Manager
+
 //System Class
 class MyEntityManager
 {
@@ -17,6 +23,16 @@ class MyEntityManager
 	uint m_uEntityCount = 0; //number of elements in the list
 	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
 	static MyEntityManager* m_pInstance; // Singleton pointer
+
+	MyOctant* m_pOctree = nullptr; //octree that tells which pairs to check, nullptr checks all pairs
+	MyLinearOctree* m_pLinearOctree = nullptr; //used instead of the octree when not nullptr
+	std::vector<EntityPair> m_lPairList; //pairs given by the octree in the last update
+	uint m_uPairCount = 0; //number of pairs checked in the last update
+	MySweepAndPrune* m_pSweepAndPrune = nullptr; //sweep and prune broadphase, used instead of the octree when not nullptr
+
+	uint m_uChunkSize = 1024; //pairs checked by each task of the narrowphase
+	std::vector<uint> m_lChunkStart; //first pair (or first row when checking all pairs) of each chunk, plus the end
+	std::vector<std::vector<EntityPair>> m_lChunkResult; //colliding pairs found by each chunk
 public:
 	/*
 	Usage: Gets the singleton pointer
@@ -246,6 +262,39 @@ public:
 	OUTPUT: MyEntity count
 	*/
 	uint GetEntityCount(void);
+	/*
+	USAGE: Sets the octree used to find the pairs of entities to check for collisions, the
+	manager does not own it and it needs to be reset before the octree is deleted
+	ARGUMENTS: MyOctant* a_pOctree -> root of the octree, nullptr checks every pair
+	OUTPUT: ---
+	*/
+	void SetOctree(MyOctant* a_pOctree);
+	/*
+	USAGE: Sets the linear octree used to find the pairs of entities to check for collisions, it
+	is used instead of the octree, the manager does not own it either
+	ARGUMENTS: MyLinearOctree* a_pOctree -> linear octree, nullptr goes back to the octree
+	OUTPUT: ---
+	*/
+	void SetLinearOctree(MyLinearOctree* a_pOctree);
+	/*
+	USAGE: Gets the number of pairs checked for collision in the last update
+	ARGUMENTS: ---
+	OUTPUT: pair count
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Turns on or off the sweep and prune broadphase, while on it is used instead of the
+	octree and the colliding lists are only changed for the pairs that start or stop overlapping
+	ARGUMENTS: bool a_bUse = true -> use sweep and prune?
+	OUTPUT: ---
+	*/
+	void UseSweepAndPrune(bool a_bUse = true);
+	/*
+	USAGE: Asks if the sweep and prune broadphase is in use
+	ARGUMENTS: ---
+	OUTPUT: is it in use?
+	*/
+	bool IsUsingSweepAndPrune(void);
 private:
 	/*
 	Usage: constructor
@@ -283,6 +332,22 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	USAGE: Checks the pairs in chunks spread across the thread pool, each chunk keeps its colliding
+	pairs in its own list and the lists are applied to the rigid bodies afterwards in chunk order,
+	so the result does not depend on which thread ran what
+	ARGUMENTS: bool a_bAllPairs -> check every pair instead of the pairs given by the octree
+	OUTPUT: ---
+	*/
+	void Narrowphase(bool a_bAllPairs);
+	/*
+	USAGE: Checks the pairs of one chunk and keeps the ones colliding, it does not change any entity
+	ARGUMENTS:
+	-	uint a_uChunk -> chunk to check
+	-	bool a_bAllPairs -> the chunk is a range of rows of every pair instead of a range of the pair list
+	OUTPUT: ---
+	*/
+	void CheckChunk(uint a_uChunk, bool a_bAllPairs);
 };//class
 
 } //namespace Simplex
@@ -0,0 +1,327 @@
+#include "MyLinearOctree.h"
+using namespace Simplex;
+//  MyLinearOctree
+void Simplex::MyLinearOctree::Init(void)
+{
+	m_uMaxLevel = 3;
+	m_uIdealEntityCount = 5;
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_v3Min = vector3(0.0f);
+	m_fSize = 0.0f;
+	m_lNode.clear();
+	m_lLeaf.clear();
+	m_lCode.clear();
+	m_lEntity.clear();
+	m_lEntityMin.clear();
+	m_lEntityMax.clear();
+}
+void Simplex::MyLinearOctree::Swap(MyLinearOctree& other)
+{
+	std::swap(m_uMaxLevel, other.m_uMaxLevel);
+	std::swap(m_uIdealEntityCount, other.m_uIdealEntityCount);
+	std::swap(m_pMeshMngr, other.m_pMeshMngr);
+	std::swap(m_pEntityMngr, other.m_pEntityMngr);
+	std::swap(m_v3Min, other.m_v3Min);
+	std::swap(m_fSize, other.m_fSize);
+	std::swap(m_lNode, other.m_lNode);
+	std::swap(m_lLeaf, other.m_lLeaf);
+	std::swap(m_lCode, other.m_lCode);
+	std::swap(m_lEntity, other.m_lEntity);
+	std::swap(m_lEntityMin, other.m_lEntityMin);
+	std::swap(m_lEntityMax, other.m_lEntityMax);
+}
+void Simplex::MyLinearOctree::Release(void)
+{
+	m_pMeshMngr = nullptr;
+	m_pEntityMngr = nullptr;
+	m_lNode.clear();
+	m_lLeaf.clear();
+	m_lCode.clear();
+	m_lEntity.clear();
+	m_lEntityMin.clear();
+	m_lEntityMax.clear();
+}
+//The big 3
+Simplex::MyLinearOctree::MyLinearOctree(uint a_nMaxLevel, uint a_nIdealEntityCount)
+{
+	Init();
+	//3 bits per level have to fit in the code
+	m_uMaxLevel = std::min(a_nMaxLevel, 21u);
+	m_uIdealEntityCount = a_nIdealEntityCount;
+	ConstructTree();
+}
+Simplex::MyLinearOctree::MyLinearOctree(MyLinearOctree const& other)
+{
+	m_uMaxLevel = other.m_uMaxLevel;
+	m_uIdealEntityCount = other.m_uIdealEntityCount;
+	m_pMeshMngr = other.m_pMeshMngr;
+	m_pEntityMngr = other.m_pEntityMngr;
+	m_v3Min = other.m_v3Min;
+	m_fSize = other.m_fSize;
+	m_lNode = other.m_lNode;
+	m_lLeaf = other.m_lLeaf;
+	m_lCode = other.m_lCode;
+	m_lEntity = other.m_lEntity;
+	m_lEntityMin = other.m_lEntityMin;
+	m_lEntityMax = other.m_lEntityMax;
+}
+Simplex::MyLinearOctree& Simplex::MyLinearOctree::operator=(MyLinearOctree const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyLinearOctree temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+Simplex::MyLinearOctree::~MyLinearOctree(void) { Release(); };
+//Accessors
+Simplex::uint Simplex::MyLinearOctree::GetOctantCount(void) { return m_lNode.size(); }
+Simplex::uint Simplex::MyLinearOctree::GetLeafCount(void) { return m_lLeaf.size(); }
+//--- Non Standard Singleton Methods
+Simplex::MyLinearOctree::MortonCode Simplex::MyLinearOctree::SpreadBits(uint a_uValue)
+{
+	MortonCode x = a_uValue & 0x1fffff;
+	x = (x | x << 32) & 0x1f00000000ffffULL;
+	x = (x | x << 16) & 0x1f0000ff0000ffULL;
+	x = (x | x << 8) & 0x100f00f00f00f00fULL;
+	x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+	x = (x | x << 2) & 0x1249249249249249ULL;
+	return x;
+}
+void Simplex::MyLinearOctree::SortByCode(void)
+{
+	uint uEntityCount = m_lCode.size();
+	std::vector<MortonCode> lCodeTemp(uEntityCount);
+	std::vector<uint> lEntityTemp(uEntityCount);
+
+	//one pass per byte of the code, each pass keeps the order of the previous one
+	uint uPassCount = (m_uMaxLevel * 3 + 7) / 8;
+	for (uint uPass = 0; uPass < uPassCount; uPass++)
+	{
+		uint uShift = uPass * 8;
+		uint uCount[257] = { 0 };
+		for (uint i = 0; i < uEntityCount; i++)
+			++uCount[((m_lCode[i] >> uShift) & 0xff) + 1];
+		for (uint i = 1; i < 257; i++)
+			uCount[i] += uCount[i - 1];
+		for (uint i = 0; i < uEntityCount; i++)
+		{
+			uint uTarget = uCount[(m_lCode[i] >> uShift) & 0xff]++;
+			lCodeTemp[uTarget] = m_lCode[i];
+			lEntityTemp[uTarget] = m_lEntity[i];
+		}
+		std::swap(m_lCode, lCodeTemp);
+		std::swap(m_lEntity, lEntityTemp);
+	}
+}
+void Simplex::MyLinearOctree::ConstructTree(void)
+{
+	m_lNode.clear();
+	m_lLeaf.clear();
+
+	//take the bounds of the entities and the cube that contains all of them
+	uint uEntityCount = m_pEntityMngr->GetEntityCount();
+	std::vector<vector3> lMin(uEntityCount);
+	std::vector<vector3> lMax(uEntityCount);
+	vector3 v3Min = vector3(0.0f);
+	vector3 v3Max = vector3(0.0f);
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		MyRigidBody* pRigidBody = m_pEntityMngr->GetRigidBody(i);
+		lMin[i] = pRigidBody->GetMinGlobal();
+		lMax[i] = pRigidBody->GetMaxGlobal();
+		v3Min = i == 0 ? lMin[i] : glm::min(v3Min, lMin[i]);
+		v3Max = i == 0 ? lMax[i] : glm::max(v3Max, lMax[i]);
+	}
+	vector3 v3HalfWidth = (v3Max - v3Min) / 2.0f;
+	float fHalfWidth = std::max(v3HalfWidth.x, std::max(v3HalfWidth.y, v3HalfWidth.z));
+	m_v3Min = v3Min + v3HalfWidth - vector3(fHalfWidth);
+	m_fSize = fHalfWidth * 2.0f;
+
+	//the code of each entity is the cell of the deepest level its center falls in
+	uint uCells = 1u << m_uMaxLevel;
+	m_lCode.resize(uEntityCount);
+	m_lEntity.resize(uEntityCount);
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		vector3 v3Cell = vector3(0.0f);
+		if (m_fSize > 0.0f)
+			v3Cell = ((lMin[i] + lMax[i]) / 2.0f - m_v3Min) / m_fSize * static_cast<float>(uCells);
+		uint uCell[3];
+		for (uint uAxis = 0; uAxis < 3; uAxis++)
+			uCell[uAxis] = static_cast<uint>(glm::clamp(v3Cell[uAxis], 0.0f, static_cast<float>(uCells - 1)));
+		m_lCode[i] = SpreadBits(uCell[0]) | (SpreadBits(uCell[1]) << 1) | (SpreadBits(uCell[2]) << 2);
+		m_lEntity[i] = i;
+	}
+	SortByCode();
+
+	m_lEntityMin.resize(uEntityCount);
+	m_lEntityMax.resize(uEntityCount);
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		m_lEntityMin[i] = lMin[m_lEntity[i]];
+		m_lEntityMax[i] = lMax[m_lEntity[i]];
+	}
+
+	//the entities of every node are together in the sorted list, splitting a node is a scan of its range
+	LinearNode root;
+	root.m_uCount = uEntityCount;
+	m_lNode.push_back(root);
+	for (uint uNode = 0; uNode < m_lNode.size(); uNode++)
+	{
+		LinearNode node = m_lNode[uNode];
+		if (node.m_uCount <= m_uIdealEntityCount || node.m_uLevel >= m_uMaxLevel)
+			continue;
+
+		m_lNode[uNode].m_uFirstChild = m_lNode.size();
+		uint uShift = 3 * (m_uMaxLevel - node.m_uLevel - 1);
+		uint uEnd = node.m_uFirst + node.m_uCount;
+		uint uPosition = node.m_uFirst;
+		for (uint uChild = 0; uChild < 8; uChild++)
+		{
+			LinearNode child;
+			child.m_uCode = (node.m_uCode << 3) | uChild;
+			child.m_uLevel = node.m_uLevel + 1;
+			child.m_uFirst = uPosition;
+			while (uPosition < uEnd && ((m_lCode[uPosition] >> uShift) & 7) == uChild)
+				++uPosition;
+			child.m_uCount = uPosition - child.m_uFirst;
+			m_lNode.push_back(child);
+		}
+	}
+
+	//children are always after their parent, so going backwards fills the bounds bottom up
+	for (int nNode = static_cast<int>(m_lNode.size()) - 1; nNode >= 0; nNode--)
+	{
+		LinearNode& node = m_lNode[nNode];
+		node.m_v3Min = vector3(FLT_MAX);
+		node.m_v3Max = vector3(-FLT_MAX);
+		if (node.m_uFirstChild == 0)
+		{
+			for (uint i = node.m_uFirst; i < node.m_uFirst + node.m_uCount; i++)
+			{
+				node.m_v3Min = glm::min(node.m_v3Min, m_lEntityMin[i]);
+				node.m_v3Max = glm::max(node.m_v3Max, m_lEntityMax[i]);
+			}
+		}
+		else
+		{
+			for (uint i = node.m_uFirstChild; i < node.m_uFirstChild + 8; i++)
+			{
+				node.m_v3Min = glm::min(node.m_v3Min, m_lNode[i].m_v3Min);
+				node.m_v3Max = glm::max(node.m_v3Max, m_lNode[i].m_v3Max);
+			}
+		}
+	}
+
+	for (uint uNode = 0; uNode < m_lNode.size(); uNode++)
+	{
+		if (m_lNode[uNode].m_uFirstChild == 0 && m_lNode[uNode].m_uCount > 0)
+			m_lLeaf.push_back(uNode);
+	}
+}
+int Simplex::MyLinearOctree::FindNode(uint a_uLevel, MortonCode a_uCode)
+{
+	if (m_lNode.empty())
+		return -1;
+
+	//each level of the code picks one of the 8 children
+	uint uNode = 0;
+	for (uint uLevel = 0; uLevel < a_uLevel; uLevel++)
+	{
+		if (m_lNode[uNode].m_uFirstChild == 0)
+			return -1;
+		uint uChild = (a_uCode >> (3 * (a_uLevel - uLevel - 1))) & 7;
+		uNode = m_lNode[uNode].m_uFirstChild + uChild;
+	}
+	return uNode;
+}
+void Simplex::MyLinearOctree::GetEntityList(uint a_nIndex, std::vector<uint>& a_lEntityList)
+{
+	if (a_nIndex >= m_lNode.size())
+		return;
+
+	LinearNode& node = m_lNode[a_nIndex];
+	a_lEntityList.insert(a_lEntityList.end(), m_lEntity.begin() + node.m_uFirst, m_lEntity.begin() + node.m_uFirst + node.m_uCount);
+}
+void Simplex::MyLinearOctree::DisplayNode(LinearNode const& a_Node, vector3 a_v3Color)
+{
+	//the cell of the node is in the code, one bit per axis on each level
+	vector3 v3Cell = vector3(0.0f);
+	for (uint uLevel = 0; uLevel < a_Node.m_uLevel; uLevel++)
+	{
+		uint uChild = (a_Node.m_uCode >> (3 * (a_Node.m_uLevel - uLevel - 1))) & 7;
+		v3Cell = v3Cell * 2.0f + vector3(uChild & 1, (uChild >> 1) & 1, (uChild >> 2) & 1);
+	}
+	float fSize = m_fSize / static_cast<float>(1u << a_Node.m_uLevel);
+	vector3 v3Center = m_v3Min + (v3Cell + vector3(0.5f)) * fSize;
+	m_pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, v3Center) * glm::scale(vector3(fSize)), a_v3Color, RENDER_WIRE);
+}
+void Simplex::MyLinearOctree::Display(uint a_nIndex, vector3 a_v3Color)
+{
+	if (a_nIndex < m_lNode.size())
+		DisplayNode(m_lNode[a_nIndex], a_v3Color);
+}
+void Simplex::MyLinearOctree::Display(vector3 a_v3Color)
+{
+	for (uint i = 0; i < m_lNode.size(); i++)
+		DisplayNode(m_lNode[i], a_v3Color);
+}
+void Simplex::MyLinearOctree::DisplayLeafs(vector3 a_v3Color)
+{
+	for (uint i = 0; i < m_lLeaf.size(); i++)
+		DisplayNode(m_lNode[m_lLeaf[i]], a_v3Color);
+}
+void Simplex::MyLinearOctree::GetCollisionPairs(std::vector<EntityPair>& a_lPairList)
+{
+	if (m_lNode.empty())
+		return;
+
+	std::vector<uint> lStack;
+	uint uEntityCount = m_lEntity.size();
+	for (uint uSorted = 0; uSorted < uEntityCount; uSorted++)
+	{
+		vector3 v3Min = m_lEntityMin[uSorted];
+		vector3 v3Max = m_lEntityMax[uSorted];
+
+		lStack.clear();
+		lStack.push_back(0);
+		while (!lStack.empty())
+		{
+			LinearNode& node = m_lNode[lStack.back()];
+			lStack.pop_back();
+
+			//every pair is found by the entity that comes first in the sorted list
+			uint uEnd = node.m_uFirst + node.m_uCount;
+			if (uEnd <= uSorted + 1)
+				continue;
+			if (v3Max.x < node.m_v3Min.x || v3Min.x > node.m_v3Max.x ||
+				v3Max.y < node.m_v3Min.y || v3Min.y > node.m_v3Max.y ||
+				v3Max.z < node.m_v3Min.z || v3Min.z > node.m_v3Max.z)
+				continue;
+
+			if (node.m_uFirstChild != 0)
+			{
+				for (uint i = 0; i < 8; i++)
+					lStack.push_back(node.m_uFirstChild + i);
+				continue;
+			}
+
+			for (uint i = std::max(node.m_uFirst, uSorted + 1); i < uEnd; i++)
+			{
+				if (v3Max.x < m_lEntityMin[i].x || v3Min.x > m_lEntityMax[i].x ||
+					v3Max.y < m_lEntityMin[i].y || v3Min.y > m_lEntityMax[i].y ||
+					v3Max.z < m_lEntityMin[i].z || v3Min.z > m_lEntityMax[i].z)
+					continue;
+
+				a_lPairList.push_back(EntityPair(
+					std::min(m_lEntity[uSorted], m_lEntity[i]),
+					std::max(m_lEntity[uSorted], m_lEntity[i])));
+			}
+		}
+	}
+}
\ No newline at end of file
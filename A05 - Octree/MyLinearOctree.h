@@ -0,0 +1,189 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+---------------------------------------------*/
+#ifndef __MYLINEAROCTREECLASS_H_
+#define __MYLINEAROCTREECLASS_H_
+
+#include "MyEntityManager.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyLinearOctree
+	{
+		typedef unsigned long long MortonCode; //3 bits per level, up to 21 levels
+
+		struct LinearNode
+		{
+			MortonCode m_uCode = 0; //prefix of the Morton codes of the entities under this node
+			uint m_uLevel = 0; //level of the node, the root is 0
+			uint m_uFirst = 0; //first entity of the node in the sorted list
+			uint m_uCount = 0; //number of entities under the node
+			uint m_uFirstChild = 0; //index of the first of the 8 children, 0 if it is a leaf
+			vector3 m_v3Min = vector3(0.0f); //minimum of the boxes of the entities under the node
+			vector3 m_v3Max = vector3(0.0f); //maximum of the boxes of the entities under the node
+		};
+
+		uint m_uMaxLevel = 3; //maximum level a node can go to
+		uint m_uIdealEntityCount = 5; //nodes with more entities than this get subdivided
+
+		MeshManager* m_pMeshMngr = nullptr;//Mesh Manager singleton
+		MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
+
+		vector3 m_v3Min = vector3(0.0f); //minimum of the root cube
+		float m_fSize = 0.0f; //size of the side of the root cube
+
+		std::vector<LinearNode> m_lNode; //all the nodes, the children of a node are next to each other
+		std::vector<uint> m_lLeaf; //nodes that are leafs and contain entities
+
+		std::vector<MortonCode> m_lCode; //Morton code of each entity, sorted
+		std::vector<uint> m_lEntity; //index (in the Entity Manager) of each entity, sorted by code
+		std::vector<vector3> m_lEntityMin; //global minimum of each entity, sorted by code
+		std::vector<vector3> m_lEntityMax; //global maximum of each entity, sorted by code
+
+	public:
+		/*
+		USAGE: Constructor, will sort all the entities the Entity Manager contains by Morton code
+		and make the nodes
+		ARGUMENTS:
+		- uint a_nMaxLevel = 3 -> Sets the maximum level of subdivision (up to 21)
+		- uint nIdealEntityCount = 5 -> Sets the ideal level of objects per node
+		OUTPUT: class object
+		*/
+		MyLinearOctree(uint a_nMaxLevel = 3, uint a_nIdealEntityCount = 5);
+		/*
+		USAGE: Copy Constructor
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyLinearOctree(MyLinearOctree const& other);
+		/*
+		USAGE: Copy Assignment Operator
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyLinearOctree& operator=(MyLinearOctree const& other);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyLinearOctree(void);
+		/*
+		USAGE: Changes object contents for other object's
+		ARGUMENTS:
+		- MyLinearOctree& other -> object to swap content from
+		OUTPUT: ---
+		*/
+		void Swap(MyLinearOctree& other);
+		/*
+		USAGE: Sorts the entities again and remakes the nodes, for when the entities moved
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ConstructTree(void);
+		/*
+		USAGE: Displays the node specified by index
+		ARGUMENTS:
+		- uint a_nIndex -> node to be displayed.
+		- vector3 a_v3Color = C_YELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void Display(uint a_nIndex, vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Displays all the nodes in the color specified
+		ARGUMENTS:
+		- vector3 a_v3Color = C_YELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void Display(vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Displays the non empty leafs
+		ARGUMENTS:
+		- vector3 a_v3Color = C_YELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void DisplayLeafs(vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Gets the pairs of entities whose boxes overlap, each entity is in the leaf of its center
+		so the search goes into every node whose entities' boxes reach the entity
+		ARGUMENTS:
+		- std::vector<EntityPair>& a_lPairList -> list the pairs get added to
+		OUTPUT: ---
+		*/
+		void GetCollisionPairs(std::vector<EntityPair>& a_lPairList);
+		/*
+		USAGE: Gets the entities under the node specified by index
+		ARGUMENTS:
+		- uint a_nIndex -> node queried
+		- std::vector<uint>& a_lEntityList -> list the indices (in the Entity Manager) get added to
+		OUTPUT: ---
+		*/
+		void GetEntityList(uint a_nIndex, std::vector<uint>& a_lEntityList);
+		/*
+		USAGE: Finds the node with the given level and code prefix
+		ARGUMENTS:
+		- uint a_uLevel -> level of the node
+		- MortonCode a_uCode -> the 3 * a_uLevel bits of the node
+		OUTPUT: index of the node, -1 if the tree does not go that deep there
+		*/
+		int FindNode(uint a_uLevel, MortonCode a_uCode);
+		/*
+		USAGE: Gets the total number of nodes
+		ARGUMENTS: ---
+		OUTPUT: node count
+		*/
+		uint GetOctantCount(void);
+		/*
+		USAGE: Gets the number of leafs that contain entities
+		ARGUMENTS: ---
+		OUTPUT: leaf count
+		*/
+		uint GetLeafCount(void);
+
+	private:
+		/*
+		USAGE: Deallocates member fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Release(void);
+		/*
+		USAGE: Allocates member fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Init(void);
+		/*
+		USAGE: Sorts the entities by code with a radix sort (8 bits per pass)
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void SortByCode(void);
+		/*
+		USAGE: Adds the cube of the node to the render list
+		ARGUMENTS:
+		- LinearNode const& a_Node -> node to display
+		- vector3 a_v3Color -> color of the volume
+		OUTPUT: ---
+		*/
+		void DisplayNode(LinearNode const& a_Node, vector3 a_v3Color);
+		/*
+		USAGE: Spreads the lower 21 bits of the number so there are 2 empty bits after each one
+		ARGUMENTS: uint a_uValue -> number to spread
+		OUTPUT: spread bits
+		*/
+		static MortonCode SpreadBits(uint a_uValue);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYLINEAROCTREECLASS_H_
+
+  /*
+  USAGE:
+  ARGUMENTS: ---
+  OUTPUT: ---
+  */
\ No newline at end of file
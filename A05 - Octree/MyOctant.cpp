@@ -1,17 +1,20 @@
 #include "MyOctant.h"
 using namespace Simplex;
 
-uint MyOctant::m_uOctantCount = 0;
+std::atomic<uint> MyOctant::m_uOctantCount(0);
 uint MyOctant::m_uMaxLevel = 3;
 uint MyOctant::m_uIdealEntityCount = 5;
+float MyOctant::m_fLooseFactor = 1.0f;
+uint MyOctant::m_uGrainSize = 256;
 
-Simplex::MyOctant::MyOctant(uint a_nMaxLevel, uint a_nIdealEntityCount)
+Simplex::MyOctant::MyOctant(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseFactor)
 {
 	//set initial variables
 	Init();
 	m_uOctantCount = 0;
 	m_uMaxLevel = a_nMaxLevel;
 	m_uIdealEntityCount = a_nIdealEntityCount;
+	m_fLooseFactor = std::max(a_fLooseFactor, 1.0f);
 	m_uID = m_uOctantCount;
 	m_pRoot = this;
 	m_lChild.clear();
@@ -74,6 +77,8 @@ Simplex::MyOctant::MyOctant(MyOctant const& other)
 	m_pParent = other.m_pParent;
 	m_pRoot = other.m_pRoot;
 	m_lChild = other.m_lChild;
+	m_lEntityMin = other.m_lEntityMin;
+	m_lEntityMax = other.m_lEntityMax;
 	m_v3Max = other.m_v3Max;
 	m_v3Min = other.m_v3Min;
 	m_pMeshMngr = MeshManager::GetInstance();
@@ -109,6 +114,8 @@ void Simplex::MyOctant::Swap(MyOctant& other)
 	std::swap(m_pParent, other.m_pParent);
 	std::swap(m_pRoot, other.m_pRoot);
 	std::swap(m_lChild, other.m_lChild);
+	std::swap(m_lEntityMin, other.m_lEntityMin);
+	std::swap(m_lEntityMax, other.m_lEntityMax);
 	std::swap(m_v3Min, other.m_v3Min);
 	std::swap(m_v3Max, other.m_v3Max);
 
@@ -148,25 +155,27 @@ bool Simplex::MyOctant::IsColliding(uint a_uRBIndex)
 	}
 	MyEntity* pEntity = m_pEntityMngr->GetEntity(a_uRBIndex);
 	MyRigidBody* pRigidBody = pEntity->GetRigidBody();
-	vector3 v3Max = pRigidBody->GetMaxGlobal();
-	vector3 v3Min = pRigidBody->GetMinGlobal();
 
+	return IsColliding(pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+}
+
+bool Simplex::MyOctant::IsColliding(vector3 a_v3Min, vector3 a_v3Max)
+{
 	//check collision by checking min max pos in all 3 axis
 	//x
-	if (m_v3Max.x < v3Min.x) return false;
-	if (m_v3Min.x > v3Max.x) return false;
+	if (m_v3Max.x < a_v3Min.x) return false;
+	if (m_v3Min.x > a_v3Max.x) return false;
 
 	//y
-	if (m_v3Max.y < v3Min.y) return false;
-	if (m_v3Min.y > v3Max.y) return false;
+	if (m_v3Max.y < a_v3Min.y) return false;
+	if (m_v3Min.y > a_v3Max.y) return false;
 
 	//z
-	if (m_v3Max.z < v3Min.z) return false;
-	if (m_v3Min.z > v3Max.z) return false;
+	if (m_v3Max.z < a_v3Min.z) return false;
+	if (m_v3Min.z > a_v3Max.z) return false;
 
 	//true if it gets this far
 	return true;
-
 }
 
 void Simplex::MyOctant::Display(uint a_nIndex, vector3 a_v3Color)
@@ -250,19 +259,82 @@ void Simplex::MyOctant::Subdivide(void)
 	v3Center.z += size * 2.0f;
 	m_pChild[7] = new MyOctant(v3Center, size * 2.0f);
 
+	//the root's snapshot of the entities bounds
+	std::vector<vector3>& lMin = m_pRoot->m_lEntityMin;
+	std::vector<vector3>& lMax = m_pRoot->m_lEntityMax;
+
 	for (int i = 0; i < 8; i++)
 	{
 		//set variables
 		m_pChild[i]->m_pRoot = m_pRoot;
 		m_pChild[i]->m_pParent = this;
 		m_pChild[i]->m_uLevel = m_uLevel+1;
+	}
+
+	//while constructing, big lists are split by the pool, every child only writes to its own subtree
+	MyThreadPool* pPool = m_pRoot->m_pThreadPool;
+	bool bParallel = pPool != nullptr && m_EntityList.size() >= m_uGrainSize;
 
-		//subdivide if space
-		if (m_pChild[i]->ContainsMoreThan(m_uIdealEntityCount))
-		{
-			m_pChild[i]->Subdivide();
+	if (IsLoose())
+	{
+		//an entity goes down to the child of its center if it fits in its loose bounds, otherwise it stays here
+		std::vector<uint> lStay;
+		uint numObj = m_EntityList.size();
+		for (uint j = 0; j < numObj; j++){
+			uint uIndex = m_EntityList[j];
+			MyOctant* pChild = GetChildByPoint((lMin[uIndex] + lMax[uIndex]) / 2.0f);
+			if (pChild->IsContainedLoose(lMin[uIndex], lMax[uIndex]))
+				pChild->m_EntityList.push_back(uIndex);
+			else
+				lStay.push_back(uIndex);
+		}
+		m_EntityList = lStay;
+	}
+
+	for (uint i = 0; i < 8; i++)
+	{
+		if (bParallel)
+			pPool->Run([this, i]() { BuildChild(i); });
+		else
+			BuildChild(i);
+	}
+
+	//not a leaf anymore, the entities now live in the children
+	//(the children of a parallel split still read the list, NumberOctants clears it)
+	if (!IsLoose() && !bParallel) m_EntityList.clear();
+}
+
+void Simplex::MyOctant::BuildChild(uint a_nChild)
+{
+	MyOctant* pChild = m_pChild[a_nChild];
+
+	if (!IsLoose())
+	{
+		//a child can only contain what its parent contains, so only this list needs checking
+		std::vector<vector3>& lMin = m_pRoot->m_lEntityMin;
+		std::vector<vector3>& lMax = m_pRoot->m_lEntityMax;
+		uint numObj = m_EntityList.size();
+		for (uint j = 0; j < numObj; j++){
+			uint uIndex = m_EntityList[j];
+			if (pChild->IsColliding(lMin[uIndex], lMax[uIndex]))
+				pChild->m_EntityList.push_back(uIndex);
 		}
 	}
+
+	//subdivide if space
+	if (pChild->m_EntityList.size() > m_uIdealEntityCount)
+	{
+		pChild->Subdivide();
+	}
+}
+
+void Simplex::MyOctant::NumberOctants(void)
+{
+	//same order the serial construction gives, the eight children one after the other and then their subtrees
+	for (int i = 0; i < m_uChildren; i++) m_pChild[i]->m_uID = m_uOctantCount++;
+	for (int i = 0; i < m_uChildren; i++) m_pChild[i]->NumberOctants();
+
+	if (m_uChildren != 0 && !IsLoose()) m_EntityList.clear();
 }
 
 MyOctant* Simplex::MyOctant::GetChild(uint a_nChild)
@@ -325,27 +397,200 @@ void Simplex::MyOctant::ConstructTree(uint a_nMaxLevel)
 	KillBranches();
 	m_lChild.clear();
 
-	if (ContainsMoreThan(m_uIdealEntityCount))
+	//read the entities only once, every octant partitions its parent's list from here
+	SnapshotEntities();
+	uint numObj = m_lEntityMin.size();
+	for (uint i = 0; i < numObj; i++){
+		//the root of a loose octree keeps whatever does not fit anywhere else
+		if (IsLoose() || IsColliding(m_lEntityMin[i], m_lEntityMax[i])) m_EntityList.push_back(i);
+	}
+
+	//the children of the octants are built by the pool when there are threads to spare
+	MyThreadPool* pPool = MyThreadPool::GetInstance();
+	if (pPool->GetThreadCount() > 1) m_pThreadPool = pPool;
+
+	if (m_EntityList.size() > m_uIdealEntityCount)
 	{
 		Subdivide();
 	}
+
+	if (m_pThreadPool != nullptr){
+		//the octants were made in whatever order the threads got to them, give them the IDs in tree order
+		pPool->Wait();
+		m_pThreadPool = nullptr;
+		m_uOctantCount = 1;
+		NumberOctants();
+	}
 	AssignIDtoEntity();
 	ConstructList();
 }
 
+void Simplex::MyOctant::Refit(std::vector<uint> const& a_lEntityList)
+{
+	if (m_uLevel != 0) return;
+
+	std::vector<MyOctant*> lTouched; //octants that got entities removed or inserted
+	bool bListChanged = false; //do we need to make the list of leafs again?
+	bool bSplitOrMerged = false; //do the octants need to be numbered again?
+
+	uint numObj = m_pEntityMngr->GetEntityCount();
+	if (m_lEntityMin.size() < numObj){
+		//entities added after the construction start with bounds that overlap nothing
+		m_lEntityMin.resize(numObj, vector3(FLT_MAX));
+		m_lEntityMax.resize(numObj, vector3(-FLT_MAX));
+	}
+
+	uint numMoved = a_lEntityList.size();
+	if (IsLoose()){
+		//each entity is in a single node, move it from the node of its old bounds to the one of its new bounds
+		for (uint i = 0; i < numMoved; i++){
+			uint uIndex = a_lEntityList[i];
+			if (uIndex >= numObj) continue;
+
+			MyOctant* pOld = FindLooseNode(m_lEntityMin[uIndex], m_lEntityMax[uIndex]);
+			auto entry = std::find(pOld->m_EntityList.begin(), pOld->m_EntityList.end(), uIndex);
+
+			GetEntityBounds(uIndex, m_lEntityMin[uIndex], m_lEntityMax[uIndex]);
+
+			MyOctant* pNew = FindLooseNode(m_lEntityMin[uIndex], m_lEntityMax[uIndex]);
+			if (entry != pOld->m_EntityList.end()){
+				if (pNew == pOld) continue;
+				pOld->m_EntityList.erase(entry);
+				if (pOld->m_EntityList.empty()) bListChanged = true;
+				lTouched.push_back(pOld);
+			}
+			if (pNew->m_EntityList.empty()) bListChanged = true;
+			pNew->m_EntityList.push_back(uIndex);
+			lTouched.push_back(pNew);
+		}
+	}
+	else{
+		for (uint i = 0; i < numMoved; i++){
+			uint uIndex = a_lEntityList[i];
+			if (uIndex >= numObj) continue;
+
+			//take it out using the bounds it had, then put it back in with the new ones
+			RemoveEntityFromLeafs(uIndex, lTouched, bListChanged);
+
+			GetEntityBounds(uIndex, m_lEntityMin[uIndex], m_lEntityMax[uIndex]);
+
+			InsertEntityInLeafs(uIndex, lTouched, bListChanged);
+		}
+	}
+
+	//sort by ID so the order of the splits (and the new IDs) does not depend on the input order
+	std::sort(lTouched.begin(), lTouched.end(), [](MyOctant* a, MyOctant* b) { return a->m_uID < b->m_uID; });
+	lTouched.erase(std::unique(lTouched.begin(), lTouched.end()), lTouched.end());
+
+	//split the leafs that grew too much (a loose entity can also have moved in or out of a branch)
+	uint numTouched = lTouched.size();
+	for (uint i = 0; i < numTouched; i++){
+		MyOctant* pLeaf = lTouched[i];
+		if (!pLeaf->IsLeaf() || pLeaf->m_uLevel >= m_uMaxLevel) continue;
+		if (pLeaf->m_EntityList.size() <= m_uIdealEntityCount * 2) continue;
+
+		pLeaf->Subdivide();
+		bListChanged = true;
+		bSplitOrMerged = true;
+	}
+
+	//merge the parents of the touched leafs, deepest first so a merge never deletes a pending parent
+	std::vector<MyOctant*> lParent;
+	for (uint i = 0; i < numTouched; i++){
+		if (lTouched[i]->m_pParent != nullptr) lParent.push_back(lTouched[i]->m_pParent);
+	}
+	std::sort(lParent.begin(), lParent.end(), [](MyOctant* a, MyOctant* b) {
+		if (a->m_uLevel != b->m_uLevel) return a->m_uLevel > b->m_uLevel;
+		return a->m_uID < b->m_uID;
+	});
+	lParent.erase(std::unique(lParent.begin(), lParent.end()), lParent.end());
+
+	uint numParents = lParent.size();
+	for (uint i = 0; i < numParents; i++){
+		if (lParent[i]->MergeChildren()){
+			bListChanged = true;
+			bSplitOrMerged = true;
+		}
+	}
+
+	//the new octants took the next IDs and the deleted ones left holes, number the tree again so the
+	//IDs go from 0 to the octant count, and give the entities the dimensions of the new IDs
+	if (bSplitOrMerged){
+		m_uOctantCount = 1;
+		NumberOctants();
+		m_pEntityMngr->ClearDimensionSetAll();
+		AssignIDtoEntity();
+	}
+
+	//only walk the tree again if a leaf appeared, disappeared or changed between empty and not
+	if (bListChanged){
+		m_lChild.clear();
+		ConstructList();
+	}
+}
+
+void Simplex::MyOctant::Refit(void)
+{
+	if (m_uLevel != 0) return;
+
+	//only the entities that moved (or were added) go through the tree
+	std::vector<uint> lMoved;
+	uint numObj = m_pEntityMngr->GetEntityCount();
+	for (uint i = 0; i < numObj; i++){
+		vector3 v3Min, v3Max;
+		GetEntityBounds(i, v3Min, v3Max);
+		if (i >= m_lEntityMin.size() || v3Min != m_lEntityMin[i] || v3Max != m_lEntityMax[i]) lMoved.push_back(i);
+	}
+	if (!lMoved.empty()) Refit(lMoved);
+}
+
 void Simplex::MyOctant::AssignIDtoEntity(void)
 {
+	//a loose octree finds its pairs walking the tree, the entities need no dimensions
+	if (IsLoose()) return;
+
 	for (int i = 0; i < m_uChildren; i++) {
 		m_pChild[i]->AssignIDtoEntity();
 	}
 
+	//the list of the leaf was already filled when its parent partitioned
 	if (m_uChildren == 0) {
-		int numEntities = m_pEntityMngr->GetEntityCount();
+		int numEntities = m_EntityList.size();
 
 		for (int i = 0; i < numEntities; i++) {
-			if (IsColliding(i)) {
-				m_EntityList.push_back(i);
-				m_pEntityMngr->AddDimension(i, m_uID);
+			m_pEntityMngr->AddDimension(m_EntityList[i], m_uID);
+		}
+	}
+}
+
+void Simplex::MyOctant::GetCollisionPairs(std::vector<EntityPair>& a_lPairList)
+{
+	if (m_uLevel != 0) return;
+
+	//every entity looks for its pairs in the nodes whose loose bounds it overlaps
+	if (IsLoose()){
+		uint numNodes = m_lChild.size();
+		for (uint i = 0; i < numNodes; i++){
+			std::vector<uint>& lList = m_lChild[i]->m_EntityList;
+			for (uint j = 0; j < lList.size(); j++) GetLoosePairs(lList[j], a_lPairList);
+		}
+		return;
+	}
+
+	uint numLeaves = m_lChild.size();
+	for (uint i = 0; i < numLeaves; i++){
+		MyOctant* pLeaf = m_lChild[i];
+		std::vector<uint>& lList = pLeaf->m_EntityList;
+		uint numObj = lList.size();
+
+		for (uint j = 0; j < numObj; j++){
+			MyEntity* pEntity = m_pEntityMngr->GetEntity(lList[j]);
+			for (uint k = j + 1; k < numObj; k++){
+				//the dimensions of an entity are the leafs it is in, skip it if another leaf already has it
+				int nShared = pEntity->GetFirstSharedDimension(m_pEntityMngr->GetEntity(lList[k]));
+				if (nShared == -1 || static_cast<uint>(nShared) != pLeaf->m_uID) continue;
+
+				a_lPairList.push_back(EntityPair(lList[j], lList[k]));
 			}
 		}
 	}
@@ -356,6 +601,11 @@ uint Simplex::MyOctant::GetOctantCount(void)
 	return m_uOctantCount;
 }
 
+bool Simplex::MyOctant::IsLoose(void)
+{
+	return m_fLooseFactor > 1.0f;
+}
+
 void Simplex::MyOctant::Release(void)
 {
 	if (m_uLevel == 0) KillBranches(); //kill it
@@ -365,6 +615,8 @@ void Simplex::MyOctant::Release(void)
 	m_fSize = 0.0;
 	m_EntityList.clear();
 	m_lChild.clear();
+	m_lEntityMin.clear();
+	m_lEntityMax.clear();
 }
 
 void Simplex::MyOctant::Init(void)
@@ -397,3 +649,160 @@ void Simplex::MyOctant::ConstructList(void)
 		m_pRoot->m_lChild.push_back(this);
 	}
 }
+
+void Simplex::MyOctant::SnapshotEntities(void)
+{
+	uint numObj = m_pEntityMngr->GetEntityCount();
+	m_lEntityMin.resize(numObj);
+	m_lEntityMax.resize(numObj);
+
+	for (uint i = 0; i < numObj; i++){
+		GetEntityBounds(i, m_lEntityMin[i], m_lEntityMax[i]);
+	}
+}
+
+void Simplex::MyOctant::GetEntityBounds(uint a_uIndex, vector3& a_v3Min, vector3& a_v3Max)
+{
+	MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(a_uIndex)->GetRigidBody();
+	a_v3Min = pRigidBody->GetMinGlobal();
+	a_v3Max = pRigidBody->GetMaxGlobal();
+
+	//the root of a loose octree keeps what went outside of it, and needs the real bounds for its pairs
+	if (IsLoose()) return;
+	a_v3Min = glm::clamp(a_v3Min, m_pRoot->m_v3Min, m_pRoot->m_v3Max);
+	a_v3Max = glm::clamp(a_v3Max, m_pRoot->m_v3Min, m_pRoot->m_v3Max);
+}
+
+void Simplex::MyOctant::RemoveEntityFromLeafs(uint a_uIndex, std::vector<MyOctant*>& a_lTouched, bool& a_bListChanged)
+{
+	if (!IsColliding(m_pRoot->m_lEntityMin[a_uIndex], m_pRoot->m_lEntityMax[a_uIndex])) return;
+
+	if (m_uChildren == 0){
+		auto entry = std::find(m_EntityList.begin(), m_EntityList.end(), a_uIndex);
+		if (entry == m_EntityList.end()) return;
+
+		m_EntityList.erase(entry);
+		m_pEntityMngr->RemoveDimension(a_uIndex, m_uID);
+		a_lTouched.push_back(this);
+		if (m_EntityList.empty()) a_bListChanged = true;
+		return;
+	}
+
+	for (int i = 0; i < m_uChildren; i++) m_pChild[i]->RemoveEntityFromLeafs(a_uIndex, a_lTouched, a_bListChanged);
+}
+
+void Simplex::MyOctant::InsertEntityInLeafs(uint a_uIndex, std::vector<MyOctant*>& a_lTouched, bool& a_bListChanged)
+{
+	if (!IsColliding(m_pRoot->m_lEntityMin[a_uIndex], m_pRoot->m_lEntityMax[a_uIndex])) return;
+
+	if (m_uChildren == 0){
+		//keep the list sorted like the construction leaves it
+		auto entry = std::lower_bound(m_EntityList.begin(), m_EntityList.end(), a_uIndex);
+		if (entry != m_EntityList.end() && *entry == a_uIndex) return;
+
+		if (m_EntityList.empty()) a_bListChanged = true;
+		m_EntityList.insert(entry, a_uIndex);
+		m_pEntityMngr->AddDimension(a_uIndex, m_uID);
+		a_lTouched.push_back(this);
+		return;
+	}
+
+	for (int i = 0; i < m_uChildren; i++) m_pChild[i]->InsertEntityInLeafs(a_uIndex, a_lTouched, a_bListChanged);
+}
+
+bool Simplex::MyOctant::MergeChildren(void)
+{
+	if (m_uChildren == 0) return false;
+
+	//only the last level of branches can be merged, a loose branch keeps its own entities too
+	std::vector<uint> lMerged = m_EntityList;
+	for (int i = 0; i < m_uChildren; i++){
+		if (!m_pChild[i]->IsLeaf()) return false;
+		lMerged.insert(lMerged.end(), m_pChild[i]->m_EntityList.begin(), m_pChild[i]->m_EntityList.end());
+	}
+
+	//an entity can be in more than one child
+	std::sort(lMerged.begin(), lMerged.end());
+	lMerged.erase(std::unique(lMerged.begin(), lMerged.end()), lMerged.end());
+	if (lMerged.size() > m_uIdealEntityCount / 2) return false;
+
+	KillBranches();
+	m_EntityList = lMerged;
+	return true;
+}
+
+bool Simplex::MyOctant::IsContainedLoose(vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3HalfWidth = vector3(m_fSize * m_fLooseFactor / 2.0f);
+	vector3 v3LooseMin = m_v3Center - v3HalfWidth;
+	vector3 v3LooseMax = m_v3Center + v3HalfWidth;
+
+	if (a_v3Min.x < v3LooseMin.x || a_v3Max.x > v3LooseMax.x) return false;
+	if (a_v3Min.y < v3LooseMin.y || a_v3Max.y > v3LooseMax.y) return false;
+	if (a_v3Min.z < v3LooseMin.z || a_v3Max.z > v3LooseMax.z) return false;
+
+	return true;
+}
+
+bool Simplex::MyOctant::IsCollidingLoose(vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3HalfWidth = vector3(m_fSize * m_fLooseFactor / 2.0f);
+	vector3 v3LooseMin = m_v3Center - v3HalfWidth;
+	vector3 v3LooseMax = m_v3Center + v3HalfWidth;
+
+	if (v3LooseMax.x < a_v3Min.x || v3LooseMin.x > a_v3Max.x) return false;
+	if (v3LooseMax.y < a_v3Min.y || v3LooseMin.y > a_v3Max.y) return false;
+	if (v3LooseMax.z < a_v3Min.z || v3LooseMin.z > a_v3Max.z) return false;
+
+	return true;
+}
+
+MyOctant* Simplex::MyOctant::GetChildByPoint(vector3 a_v3Point)
+{
+	if (m_uChildren == 0) return nullptr;
+
+	//the children are not in bit order (see Subdivide), this maps x + 2y + 4z to the child
+	static const uint uChildByBits[8] = { 0, 1, 5, 6, 3, 2, 4, 7 };
+	uint uBits = 0;
+	if (a_v3Point.x >= m_v3Center.x) uBits |= 1;
+	if (a_v3Point.y >= m_v3Center.y) uBits |= 2;
+	if (a_v3Point.z >= m_v3Center.z) uBits |= 4;
+	return m_pChild[uChildByBits[uBits]];
+}
+
+MyOctant* Simplex::MyOctant::FindLooseNode(vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3Center = (a_v3Min + a_v3Max) / 2.0f;
+	MyOctant* pNode = this;
+	while (pNode->m_uChildren != 0){
+		MyOctant* pChild = pNode->GetChildByPoint(v3Center);
+		if (!pChild->IsContainedLoose(a_v3Min, a_v3Max)) break;
+		pNode = pChild;
+	}
+	return pNode;
+}
+
+void Simplex::MyOctant::GetLoosePairs(uint a_uIndex, std::vector<EntityPair>& a_lPairList)
+{
+	vector3 v3Min = m_pRoot->m_lEntityMin[a_uIndex];
+	vector3 v3Max = m_pRoot->m_lEntityMax[a_uIndex];
+
+	//the root also holds what went outside of it, so it is always checked
+	if (m_uLevel != 0 && !IsCollidingLoose(v3Min, v3Max)) return;
+
+	uint numObj = m_EntityList.size();
+	for (uint i = 0; i < numObj; i++){
+		uint uOther = m_EntityList[i];
+		if (uOther <= a_uIndex) continue;
+
+		vector3 v3OtherMin = m_pRoot->m_lEntityMin[uOther];
+		vector3 v3OtherMax = m_pRoot->m_lEntityMax[uOther];
+		if (v3Max.x < v3OtherMin.x || v3Min.x > v3OtherMax.x) continue;
+		if (v3Max.y < v3OtherMin.y || v3Min.y > v3OtherMax.y) continue;
+		if (v3Max.z < v3OtherMin.z || v3Min.z > v3OtherMax.z) continue;
+
+		a_lPairList.push_back(EntityPair(a_uIndex, uOther));
+	}
+
+	for (int i = 0; i < m_uChildren; i++) m_pChild[i]->GetLoosePairs(a_uIndex, a_lPairList);
+}
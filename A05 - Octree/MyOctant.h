@@ -6,6 +6,8 @@ Date: 2019
 #define __MYOCTANTCLASS_H_
 
 #include "MyEntityManager.h"
+#include "MyThreadPool.h"
+#include <atomic>
 
 namespace Simplex
 {
@@ -13,9 +15,11 @@ namespace Simplex
 	//System Class
 	class MyOctant
 	{
-		static uint m_uOctantCount; //will store the number of octants instantiated
+		static std::atomic<uint> m_uOctantCount; //will store the number of octants instantiated
 		static uint m_uMaxLevel;//will store the maximum level an octant can go to
 		static uint m_uIdealEntityCount; //will tell how many ideal Entities this object will contain
+		static float m_fLooseFactor; //how much bigger than its octant a node's loose bounds are, 1 is a regular octree
+		static uint m_uGrainSize; //octants with fewer entities than this build their children on the same thread
 
 		uint m_uID = 0; //Will store the current ID for this octant
 		uint m_uLevel = 0; //Will store the current level of the octant
@@ -38,6 +42,10 @@ namespace Simplex
 		MyOctant* m_pRoot = nullptr;//Root octant
 		std::vector<MyOctant*> m_lChild; //list of nodes that contain objects (this will be applied to root only)
 
+		std::vector<vector3> m_lEntityMin; //global minimum of each entity as the tree last took it (root only)
+		std::vector<vector3> m_lEntityMax; //global maximum of each entity as the tree last took it (root only)
+		MyThreadPool* m_pThreadPool = nullptr; //pool the construction is split across, nullptr outside of it (root only)
+
 	public:
 		/*
 		USAGE: Constructor, will create an octant containing all MagnaEntities Instances in the Mesh
@@ -45,9 +53,11 @@ namespace Simplex
 		ARGUMENTS:
 		- uint a_nMaxLevel = 2 -> Sets the maximum level of subdivision
 		- uint nIdealEntityCount = 5 -> Sets the ideal level of objects per octant
+		- float a_fLooseFactor = 1.0f -> Sets the loose factor, more than 1 makes a loose octree where
+		every entity lives in the one node whose loose bounds (the octant scaled by this factor) fit it
 		OUTPUT: class object
 		*/
-		MyOctant(uint a_nMaxLevel = 2, uint a_nIdealEntityCount = 5);
+		MyOctant(uint a_nMaxLevel = 2, uint a_nIdealEntityCount = 5, float a_fLooseFactor = 1.0f);
 		/*
 		USAGE: Constructor
 		ARGUMENTS:
@@ -142,7 +152,8 @@ namespace Simplex
 		*/
 		void ClearEntityList(void);
 		/*
-		USAGE: allocates 8 smaller octants in the child pointers
+		USAGE: allocates 8 smaller octants in the child pointers, each child receives the entities
+		of this octant's list that overlap it and subdivides further if it holds too many
 		ARGUMENTS: ---
 		OUTPUT: ---
 		*/
@@ -186,11 +197,36 @@ namespace Simplex
 		*/
 		void ConstructTree(uint a_nMaxLevel = 3);
 		/*
+		USAGE: Updates the tree for the entities that moved since the last construction, only those
+		entities are taken out of the leafs they were in and inserted in the leafs they overlap now;
+		touched leafs split when they hold more than twice the ideal count and sibling leafs merge
+		back into their parent when together they hold half of it or less, after which the octants are
+		numbered again; an entity that left the root stays in the leafs at its border (root only)
+		ARGUMENTS:
+		- std::vector<uint> const& a_lEntityList -> indices (in the Entity Manager) of the moved entities
+		OUTPUT: ---
+		*/
+		void Refit(std::vector<uint> const& a_lEntityList);
+		/*
+		USAGE: Refits the entities whose bounds changed since the tree last took them (root only)
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Refit(void);
+		/*
 		USAGE: Traverse the tree up to the leafs and sets the objects in them to the index
 		ARGUMENTS: ---
 		OUTPUT: ---
 		*/
 		void AssignIDtoEntity(void);
+		/*
+		USAGE: Gets the pairs of entities that share a leaf, a pair that shares more than one leaf
+		is only added once (by the leaf with the lowest ID both share) (root only)
+		ARGUMENTS:
+		- std::vector<EntityPair>& a_lPairList -> list the pairs get added to
+		OUTPUT: ---
+		*/
+		void GetCollisionPairs(std::vector<EntityPair>& a_lPairList);
 
 		/*
 		USAGE: Gets the total number of octants in the world
@@ -198,6 +234,12 @@ namespace Simplex
 		OUTPUT: ---
 		*/
 		uint GetOctantCount(void);
+		/*
+		USAGE: Asks if this is a loose octree
+		ARGUMENTS: ---
+		OUTPUT: is the loose factor more than 1?
+		*/
+		bool IsLoose(void);
 
 	private:
 		/*
@@ -218,6 +260,111 @@ namespace Simplex
 		OUTPUT: ---
 		*/
 		void ConstructList(void);
+		/*
+		USAGE: Copies the global bounds of every entity in the Entity Manager into the root's
+		contiguous arrays so construction does not need to query the entities again
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void SnapshotEntities(void);
+		/*
+		USAGE: Gets the global bounds of the entity the way the tree keeps them, a regular octree clamps
+		them into the root so an entity that left it stays in the leafs at the border nearest to it
+		(two clamped boxes still overlap if the boxes did, so no pair is lost)
+		ARGUMENTS:
+		- uint a_uIndex -> Index of the Entity in the Entity Manager
+		- vector3& a_v3Min -> out: minimum of the bounds
+		- vector3& a_v3Max -> out: maximum of the bounds
+		OUTPUT: ---
+		*/
+		void GetEntityBounds(uint a_uIndex, vector3& a_v3Min, vector3& a_v3Max);
+		/*
+		USAGE: Gives the child the entities of this octant it collides with and subdivides it if it got
+		too many, only touches the subtree of the child so the children can be built at the same time
+		ARGUMENTS: uint a_nChild -> child to build
+		OUTPUT: ---
+		*/
+		void BuildChild(uint a_nChild);
+		/*
+		USAGE: Gives the octants under this one their IDs in the order a construction on a single thread
+		would, and empties the lists of the branches a parallel construction could not empty yet
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void NumberOctants(void);
+		/*
+		USAGE: Asks if the volume specified by global min and max overlaps this octant
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the volume in global space
+		- vector3 a_v3Max -> maximum of the volume in global space
+		OUTPUT: check of the collision
+		*/
+		bool IsColliding(vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Takes the entity out of every leaf its snapshot bounds overlap
+		ARGUMENTS:
+		- uint a_uIndex -> Index of the Entity in the Entity Manager
+		- std::vector<MyOctant*>& a_lTouched -> leafs that were modified get added here
+		- bool& a_bListChanged -> set to true if a leaf was left empty
+		OUTPUT: ---
+		*/
+		void RemoveEntityFromLeafs(uint a_uIndex, std::vector<MyOctant*>& a_lTouched, bool& a_bListChanged);
+		/*
+		USAGE: Puts the entity in every leaf its snapshot bounds overlap
+		ARGUMENTS:
+		- uint a_uIndex -> Index of the Entity in the Entity Manager
+		- std::vector<MyOctant*>& a_lTouched -> leafs that were modified get added here
+		- bool& a_bListChanged -> set to true if an empty leaf received the entity
+		OUTPUT: ---
+		*/
+		void InsertEntityInLeafs(uint a_uIndex, std::vector<MyOctant*>& a_lTouched, bool& a_bListChanged);
+		/*
+		USAGE: Deletes the children if all of them are leafs and together they hold half the ideal count
+		of entities or less (counting its own if loose), this octant becomes a leaf holding their entities
+		ARGUMENTS: ---
+		OUTPUT: were the children merged?
+		*/
+		bool MergeChildren(void);
+		/*
+		USAGE: Asks if the volume specified by global min and max fits inside the loose bounds of this octant
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the volume in global space
+		- vector3 a_v3Max -> maximum of the volume in global space
+		OUTPUT: does it fit?
+		*/
+		bool IsContainedLoose(vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Asks if the volume specified by global min and max overlaps the loose bounds of this octant
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the volume in global space
+		- vector3 a_v3Max -> maximum of the volume in global space
+		OUTPUT: check of the collision
+		*/
+		bool IsCollidingLoose(vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Gets the child whose octant contains the point
+		ARGUMENTS: vector3 a_v3Point -> point in global space
+		OUTPUT: child octant, nullptr if this is a leaf
+		*/
+		MyOctant* GetChildByPoint(vector3 a_v3Point);
+		/*
+		USAGE: Walks down from this octant to the node a volume belongs to in a loose octree, the deepest
+		one on the path of its center whose loose bounds still fit it
+		ARGUMENTS:
+		- vector3 a_v3Min -> minimum of the volume in global space
+		- vector3 a_v3Max -> maximum of the volume in global space
+		OUTPUT: node of the volume
+		*/
+		MyOctant* FindLooseNode(vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Adds the pairs of the entity with the entities of this node and the nodes under it whose
+		loose bounds it overlaps, only with entities of a larger index so each pair is added once
+		ARGUMENTS:
+		- uint a_uIndex -> Index of the Entity in the Entity Manager
+		- std::vector<EntityPair>& a_lPairList -> list the pairs get added to
+		OUTPUT: ---
+		*/
+		void GetLoosePairs(uint a_uIndex, std::vector<EntityPair>& a_lPairList);
 	};//class
 
 } //namespace Simplex
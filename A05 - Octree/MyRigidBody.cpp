@@ -255,7 +255,7 @@ void MyRigidBody::RemoveCollisionWith(MyRigidBody* other)
 			pTemp = new PRigidBody[m_nCollidingCount - 1];
 			if (m_CollidingArray)
 			{
-				memcpy(pTemp, m_CollidingArray, sizeof(uint) * (m_nCollidingCount - 1));
+				memcpy(pTemp, m_CollidingArray, sizeof(MyRigidBody*) * (m_nCollidingCount - 1));
 				delete[] m_CollidingArray;
 				m_CollidingArray = nullptr;
 			}
@@ -291,7 +291,7 @@ uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
 	//there is no axis test that separates this two objects
 	return 0;
 }
-bool MyRigidBody::IsColliding(MyRigidBody* const a_pOther)
+bool MyRigidBody::IsOverlapping(MyRigidBody* const a_pOther)
 {
 	//check if spheres are colliding
 	bool bColliding = true;
@@ -313,19 +313,18 @@ bool MyRigidBody::IsColliding(MyRigidBody* const a_pOther)
 			bColliding = false;
 		if (this->m_v3MinG.z > a_pOther->m_v3MaxG.z) //this in front of other
 			bColliding = false;
-
-		if (bColliding) //they are colliding with bounding box also
-		{
-			this->AddCollisionWith(a_pOther);
-			a_pOther->AddCollisionWith(this);
-		}
-		else //they are not colliding with bounding box
-		{
-			this->RemoveCollisionWith(a_pOther);
-			a_pOther->RemoveCollisionWith(this);
-		}
 	}
-	else //they are not colliding with bounding sphere
+	return bColliding;
+}
+bool MyRigidBody::IsColliding(MyRigidBody* const a_pOther)
+{
+	bool bColliding = IsOverlapping(a_pOther);
+	if (bColliding) //they are colliding with bounding box also
+	{
+		this->AddCollisionWith(a_pOther);
+		a_pOther->AddCollisionWith(this);
+	}
+	else //they are not colliding with bounding box
 	{
 		this->RemoveCollisionWith(a_pOther);
 		a_pOther->RemoveCollisionWith(this);
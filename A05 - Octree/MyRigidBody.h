@@ -108,6 +108,14 @@ public:
 	OUTPUT: are they colliding?
 	*/
 	bool IsColliding(MyRigidBody* const other);
+
+	/*
+	USAGE: Tells if the object overlaps the incoming one without marking the collision in either,
+	safe to call from several threads at once while no one changes the bodies
+	ARGUMENTS: MyRigidBody* const a_pOther -> inspected rigid body
+	OUTPUT: are they overlapping?
+	*/
+	bool IsOverlapping(MyRigidBody* const a_pOther);
 #pragma region Accessors
 	/*
 	Usage: Gets visibility of bounding sphere
@@ -0,0 +1,263 @@
+#include "MySweepAndPrune.h"
+using namespace Simplex;
+//  MySweepAndPrune
+void Simplex::MySweepAndPrune::Init(void)
+{
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_lBody.clear();
+	m_lMin.clear();
+	m_lMax.clear();
+	for (uint i = 0; i < 3; i++)
+		m_lEndpoint[i].clear();
+	m_lBeginList.clear();
+	m_lEndList.clear();
+	m_uSwapCount = 0;
+	m_uPairCount = 0;
+}
+void Simplex::MySweepAndPrune::Swap(MySweepAndPrune& other)
+{
+	std::swap(m_pEntityMngr, other.m_pEntityMngr);
+	std::swap(m_lBody, other.m_lBody);
+	std::swap(m_lMin, other.m_lMin);
+	std::swap(m_lMax, other.m_lMax);
+	for (uint i = 0; i < 3; i++)
+		std::swap(m_lEndpoint[i], other.m_lEndpoint[i]);
+	std::swap(m_lBeginList, other.m_lBeginList);
+	std::swap(m_lEndList, other.m_lEndList);
+	std::swap(m_uSwapCount, other.m_uSwapCount);
+	std::swap(m_uPairCount, other.m_uPairCount);
+}
+void Simplex::MySweepAndPrune::Release(void)
+{
+	m_pEntityMngr = nullptr;
+	m_lBody.clear();
+	m_lMin.clear();
+	m_lMax.clear();
+	for (uint i = 0; i < 3; i++)
+		m_lEndpoint[i].clear();
+	m_lBeginList.clear();
+	m_lEndList.clear();
+	m_uSwapCount = 0;
+	m_uPairCount = 0;
+}
+//The big 3
+Simplex::MySweepAndPrune::MySweepAndPrune(void)
+{
+	Init();
+	Build();
+}
+Simplex::MySweepAndPrune::MySweepAndPrune(MySweepAndPrune const& other)
+{
+	m_pEntityMngr = other.m_pEntityMngr;
+	m_lBody = other.m_lBody;
+	m_lMin = other.m_lMin;
+	m_lMax = other.m_lMax;
+	for (uint i = 0; i < 3; i++)
+		m_lEndpoint[i] = other.m_lEndpoint[i];
+	m_lBeginList = other.m_lBeginList;
+	m_lEndList = other.m_lEndList;
+	m_uSwapCount = other.m_uSwapCount;
+	m_uPairCount = other.m_uPairCount;
+}
+Simplex::MySweepAndPrune& Simplex::MySweepAndPrune::operator=(MySweepAndPrune const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MySweepAndPrune temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+Simplex::MySweepAndPrune::~MySweepAndPrune() { Release(); };
+//Accessors
+std::vector<EntityPair> const& Simplex::MySweepAndPrune::GetBeginList(void) { return m_lBeginList; }
+std::vector<EntityPair> const& Simplex::MySweepAndPrune::GetEndList(void) { return m_lEndList; }
+Simplex::uint Simplex::MySweepAndPrune::GetSwapCount(void) { return m_uSwapCount; }
+Simplex::uint Simplex::MySweepAndPrune::GetPairCount(void) { return m_uPairCount; }
+//--- Non Standard Singleton Methods
+bool Simplex::MySweepAndPrune::IsLess(Endpoint const& a_A, Endpoint const& a_B)
+{
+	if (a_A.m_fValue != a_B.m_fValue)
+		return a_A.m_fValue < a_B.m_fValue;
+	//on a tie the minimum goes first, the same as MyRigidBody::IsColliding touching counts as colliding
+	return a_A.m_bMin && !a_B.m_bMin;
+}
+void Simplex::MySweepAndPrune::ReadBounds(void)
+{
+	uint uBodyCount = m_lBody.size();
+	m_lMin.resize(uBodyCount);
+	m_lMax.resize(uBodyCount);
+	for (uint i = 0; i < uBodyCount; i++)
+	{
+		m_lMin[i] = m_lBody[i]->GetMinGlobal();
+		m_lMax[i] = m_lBody[i]->GetMaxGlobal();
+	}
+}
+bool Simplex::MySweepAndPrune::IsOverlapping(uint a_uBodyA, uint a_uBodyB)
+{
+	vector3 v3MinA = m_lMin[a_uBodyA];
+	vector3 v3MaxA = m_lMax[a_uBodyA];
+	vector3 v3MinB = m_lMin[a_uBodyB];
+	vector3 v3MaxB = m_lMax[a_uBodyB];
+
+	if (v3MaxA.x < v3MinB.x || v3MinA.x > v3MaxB.x)
+		return false;
+	if (v3MaxA.y < v3MinB.y || v3MinA.y > v3MaxB.y)
+		return false;
+	if (v3MaxA.z < v3MinB.z || v3MinA.z > v3MaxB.z)
+		return false;
+
+	return true;
+}
+void Simplex::MySweepAndPrune::BeginOverlap(uint a_uBodyA, uint a_uBodyB)
+{
+	MyRigidBody* pBodyA = m_lBody[a_uBodyA];
+	MyRigidBody* pBodyB = m_lBody[a_uBodyB];
+	//the pair can be reported by more than one axis
+	if (pBodyA->IsInCollidingArray(pBodyB))
+		return;
+
+	pBodyA->AddCollisionWith(pBodyB);
+	pBodyB->AddCollisionWith(pBodyA);
+	m_lBeginList.push_back(EntityPair(std::min(a_uBodyA, a_uBodyB), std::max(a_uBodyA, a_uBodyB)));
+}
+void Simplex::MySweepAndPrune::EndOverlap(uint a_uBodyA, uint a_uBodyB)
+{
+	MyRigidBody* pBodyA = m_lBody[a_uBodyA];
+	MyRigidBody* pBodyB = m_lBody[a_uBodyB];
+	//the pair can be reported by more than one axis
+	if (!pBodyA->IsInCollidingArray(pBodyB))
+		return;
+
+	pBodyA->RemoveCollisionWith(pBodyB);
+	pBodyB->RemoveCollisionWith(pBodyA);
+	m_lEndList.push_back(EntityPair(std::min(a_uBodyA, a_uBodyB), std::max(a_uBodyA, a_uBodyB)));
+}
+void Simplex::MySweepAndPrune::Build(void)
+{
+	m_lBeginList.clear();
+	m_lEndList.clear();
+	m_uSwapCount = 0;
+	m_uPairCount = 0;
+
+	//take the rigid bodies from the entity manager and forget their old collisions
+	uint uBodyCount = m_pEntityMngr->GetEntityCount();
+	m_lBody.resize(uBodyCount);
+	for (uint i = 0; i < uBodyCount; i++)
+	{
+		m_lBody[i] = m_pEntityMngr->GetRigidBody(i);
+		m_lBody[i]->ClearCollidingList();
+	}
+	ReadBounds();
+
+	//sort all the endpoints from scratch
+	for (uint uAxis = 0; uAxis < 3; uAxis++)
+	{
+		std::vector<Endpoint>& lEndpoint = m_lEndpoint[uAxis];
+		lEndpoint.resize(uBodyCount * 2);
+		for (uint i = 0; i < uBodyCount; i++)
+		{
+			lEndpoint[i * 2].m_fValue = m_lMin[i][uAxis];
+			lEndpoint[i * 2].m_uBody = i;
+			lEndpoint[i * 2].m_bMin = true;
+			lEndpoint[i * 2 + 1].m_fValue = m_lMax[i][uAxis];
+			lEndpoint[i * 2 + 1].m_uBody = i;
+			lEndpoint[i * 2 + 1].m_bMin = false;
+		}
+		std::sort(lEndpoint.begin(), lEndpoint.end(), IsLess);
+	}
+
+	//sweep the x axis keeping the bodies we are inside of, only those can overlap the next one
+	std::vector<uint> lActive;
+	std::vector<Endpoint>& lEndpoint = m_lEndpoint[0];
+	for (uint i = 0; i < lEndpoint.size(); i++)
+	{
+		uint uBody = lEndpoint[i].m_uBody;
+		if (lEndpoint[i].m_bMin)
+		{
+			m_uPairCount += lActive.size();
+			for (uint j = 0; j < lActive.size(); j++)
+			{
+				if (IsOverlapping(uBody, lActive[j]))
+					BeginOverlap(uBody, lActive[j]);
+			}
+			lActive.push_back(uBody);
+		}
+		else
+		{
+			for (uint j = 0; j < lActive.size(); j++)
+			{
+				if (lActive[j] == uBody)
+				{
+					std::swap(lActive[j], lActive.back());
+					lActive.pop_back();
+					break;
+				}
+			}
+		}
+	}
+}
+void Simplex::MySweepAndPrune::SortAxis(uint a_uAxis)
+{
+	std::vector<Endpoint>& lEndpoint = m_lEndpoint[a_uAxis];
+	uint uEndpointCount = lEndpoint.size();
+	for (uint i = 1; i < uEndpointCount; i++)
+	{
+		Endpoint key = lEndpoint[i];
+		uint j = i;
+		//move the endpoint down until it is in order, every endpoint it passes changes side
+		while (j > 0 && IsLess(key, lEndpoint[j - 1]))
+		{
+			Endpoint& other = lEndpoint[j - 1];
+			if (key.m_bMin && !other.m_bMin) //a minimum went past a maximum, they might overlap now
+			{
+				++m_uPairCount;
+				if (IsOverlapping(key.m_uBody, other.m_uBody))
+					BeginOverlap(key.m_uBody, other.m_uBody);
+			}
+			else if (!key.m_bMin && other.m_bMin) //a maximum went past a minimum, they are apart now
+			{
+				EndOverlap(key.m_uBody, other.m_uBody);
+			}
+			lEndpoint[j] = other;
+			--j;
+			++m_uSwapCount;
+		}
+		lEndpoint[j] = key;
+	}
+}
+void Simplex::MySweepAndPrune::Update(void)
+{
+	//if the entities changed since the last update the lists need to be made again
+	uint uBodyCount = m_pEntityMngr->GetEntityCount();
+	bool bChanged = uBodyCount != m_lBody.size();
+	for (uint i = 0; i < uBodyCount && !bChanged; i++)
+	{
+		bChanged = m_lBody[i] != m_pEntityMngr->GetRigidBody(i);
+	}
+	if (bChanged)
+	{
+		Build();
+		return;
+	}
+
+	m_lBeginList.clear();
+	m_lEndList.clear();
+	m_uSwapCount = 0;
+	m_uPairCount = 0;
+
+	//read the new bounds and put them in the endpoints, they are almost in order already
+	ReadBounds();
+	for (uint uAxis = 0; uAxis < 3; uAxis++)
+	{
+		std::vector<Endpoint>& lEndpoint = m_lEndpoint[uAxis];
+		for (uint i = 0; i < lEndpoint.size(); i++)
+		{
+			uint uBody = lEndpoint[i].m_uBody;
+			lEndpoint[i].m_fValue = lEndpoint[i].m_bMin ? m_lMin[uBody][uAxis] : m_lMax[uBody][uAxis];
+		}
+		SortAxis(uAxis);
+	}
+}
\ No newline at end of file
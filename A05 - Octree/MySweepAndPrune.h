@@ -0,0 +1,175 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+---------------------------------------------*/
+#ifndef __MYSWEEPANDPRUNECLASS_H_
+#define __MYSWEEPANDPRUNECLASS_H_
+
+#include "MyEntityManager.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MySweepAndPrune
+	{
+		struct Endpoint
+		{
+			float m_fValue = 0.0f; //position of the endpoint along the axis
+			uint m_uBody = 0; //index of the body (in the Entity Manager) this endpoint belongs to
+			bool m_bMin = true; //is this the minimum of the body or the maximum?
+		};
+
+		MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
+
+		std::vector<MyRigidBody*> m_lBody; //rigid bodies in the sweep (index in Entity Manager)
+		std::vector<vector3> m_lMin; //global minimum of each body at the last update
+		std::vector<vector3> m_lMax; //global maximum of each body at the last update
+
+		std::vector<Endpoint> m_lEndpoint[3]; //endpoints of every body kept sorted on each axis
+
+		std::vector<EntityPair> m_lBeginList; //pairs that started overlapping in the last update
+		std::vector<EntityPair> m_lEndList; //pairs that stopped overlapping in the last update
+		uint m_uSwapCount = 0; //number of endpoints swapped in the last update
+		uint m_uPairCount = 0; //number of pairs whose boxes were tested in the last update
+
+	public:
+		/*
+		USAGE: Constructor, will sort the bounds of all the entities the Entity Manager contains
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		MySweepAndPrune(void);
+		/*
+		USAGE: Copy Constructor
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MySweepAndPrune(MySweepAndPrune const& other);
+		/*
+		USAGE: Copy Assignment Operator
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MySweepAndPrune& operator=(MySweepAndPrune const& other);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MySweepAndPrune(void);
+		/*
+		USAGE: Changes object contents for other object's
+		ARGUMENTS:
+		- MySweepAndPrune& other -> object to swap content from
+		OUTPUT: ---
+		*/
+		void Swap(MySweepAndPrune& other);
+		/*
+		USAGE: Sorts the endpoints of all the entities from scratch and sets the colliding list of
+		their rigid bodies to the pairs that overlap, needed when entities are added or removed
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Build(void);
+		/*
+		USAGE: Reads the new bounds of the bodies and fixes the order of the endpoints with an
+		insertion sort, every swap between a minimum and a maximum marks or unmarks the collision
+		of both rigid bodies so the colliding lists do not need to be cleared every frame
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Update(void);
+		/*
+		USAGE: Gets the pairs that started overlapping in the last update
+		ARGUMENTS: ---
+		OUTPUT: list of pairs (indices in the Entity Manager)
+		*/
+		std::vector<EntityPair> const& GetBeginList(void);
+		/*
+		USAGE: Gets the pairs that stopped overlapping in the last update
+		ARGUMENTS: ---
+		OUTPUT: list of pairs (indices in the Entity Manager)
+		*/
+		std::vector<EntityPair> const& GetEndList(void);
+		/*
+		USAGE: Gets the number of endpoints swapped in the last update
+		ARGUMENTS: ---
+		OUTPUT: swap count
+		*/
+		uint GetSwapCount(void);
+		/*
+		USAGE: Gets the number of pairs whose boxes were tested in the last update
+		ARGUMENTS: ---
+		OUTPUT: pair count
+		*/
+		uint GetPairCount(void);
+
+	private:
+		/*
+		USAGE: Deallocates member fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Release(void);
+		/*
+		USAGE: Allocates member fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Init(void);
+		/*
+		USAGE: Copies the global bounds of every body
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ReadBounds(void);
+		/*
+		USAGE: Insertion sort of the endpoints in one axis, reporting the overlaps that change
+		ARGUMENTS: uint a_uAxis -> axis to sort (0 to 2)
+		OUTPUT: ---
+		*/
+		void SortAxis(uint a_uAxis);
+		/*
+		USAGE: Asks if the bounds of both bodies overlap in all 3 axis
+		ARGUMENTS:
+		- uint a_uBodyA -> index of the first body
+		- uint a_uBodyB -> index of the second body
+		OUTPUT: are they overlapping?
+		*/
+		bool IsOverlapping(uint a_uBodyA, uint a_uBodyB);
+		/*
+		USAGE: Marks the collision between both bodies if it was not marked already
+		ARGUMENTS:
+		- uint a_uBodyA -> index of the first body
+		- uint a_uBodyB -> index of the second body
+		OUTPUT: ---
+		*/
+		void BeginOverlap(uint a_uBodyA, uint a_uBodyB);
+		/*
+		USAGE: Removes the collision between both bodies if it was marked
+		ARGUMENTS:
+		- uint a_uBodyA -> index of the first body
+		- uint a_uBodyB -> index of the second body
+		OUTPUT: ---
+		*/
+		void EndOverlap(uint a_uBodyA, uint a_uBodyB);
+		/*
+		USAGE: Order of the endpoints, on a tie minimums go first so touching bodies overlap
+		ARGUMENTS:
+		- Endpoint const& a_A -> first endpoint
+		- Endpoint const& a_B -> second endpoint
+		OUTPUT: does a_A go before a_B?
+		*/
+		static bool IsLess(Endpoint const& a_A, Endpoint const& a_B);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYSWEEPANDPRUNECLASS_H_
+
+  /*
+  USAGE:
+  ARGUMENTS: ---
+  OUTPUT: ---
+  */
\ No newline at end of file
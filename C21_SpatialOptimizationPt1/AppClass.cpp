@@ -19,7 +19,6 @@ void Application::InitVariables(void)
 	uint uInstances = 500;
 	int nSquare = static_cast<int>(std::sqrt(uInstances));
 	uInstances = nSquare * nSquare;
-	uint uIndex = 0;
 	for (int i = 0; i < nSquare; i++)
 	{
 		for (int j = 0; j < nSquare; j++)
@@ -28,26 +27,11 @@ void Application::InitVariables(void)
 			vector3 v3Position = vector3(glm::sphericalRand(34.0f));
 			matrix4 m4Position = glm::translate(v3Position);
 			m_pEntityMngr->SetModelMatrix(m4Position);
-			//m_pEntityMngr->AddDimension(-1, uIndex);
-			//++uIndex;
-			
-			if (v3Position.x < 0.0f)
-			{
-				if (v3Position.x < -17.0f)
-					m_pEntityMngr->AddDimension(-1, 1);
-				else
-					m_pEntityMngr->AddDimension(-1, 2);
-			}
-			else if (v3Position.x > 0.0f)
-			{
-				if (v3Position.x > 17.0f)
-					m_pEntityMngr->AddDimension(-1, 3);
-				else
-					m_pEntityMngr->AddDimension(-1, 4);
-			}
-			
 		}
 	}
+	//let the grid find the entities that can collide instead of setting dimensions by hand
+	m_pEntityMngr->UseSpatialHash();
+	m_pEntityMngr->SetCellSize(4.0f);
 	m_pEntityMngr->Update();
 	//steve
 	//m_pEntityMngr->AddEntity("Minecraft\\Steve.obj", "Steve");
@@ -67,8 +51,6 @@ void Application::Update(void)
 	m_pEntityMngr->Update();
 
 	m_pMeshMngr->AddGridToRenderList(glm::rotate(IDENTITY_M4, 1.5708f, AXIS_Y));
-	m_pMeshMngr->AddGridToRenderList(glm::translate(vector3(-17.0f, 0.0f, 0.0f)) * glm::rotate(IDENTITY_M4, 1.5708f, AXIS_Y));
-	m_pMeshMngr->AddGridToRenderList(glm::translate(vector3(17.0f, 0.0f, 0.0f)) * glm::rotate(IDENTITY_M4, 1.5708f, AXIS_Y));
 		
 	//Add objects to render list
 	m_pEntityMngr->AddEntityToRenderList(-1, true);
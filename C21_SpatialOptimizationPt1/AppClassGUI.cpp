@@ -38,6 +38,9 @@ void Application::DrawGUI(void)
 			ImGui::TextColored(v4Color, m_sProgrammer.c_str());
 			ImGui::Text("FrameRate: %.2f [FPS] -> %.3f [ms/frame]\n",
 				ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+			ImGui::Text("Cell size: %.2f\n", m_pEntityMngr->GetCellSize());
+			ImGui::Text("Pairs checked: %d\n", m_pEntityMngr->GetPairCount());
+			ImGui::Text("Pairs colliding: %d\n", m_pEntityMngr->GetPairManager()->GetPairCount());
 			ImGui::Text("Control:\n");
 			ImGui::Text("   WASD: Movement\n");
 			ImGui::Text("	 F1: Perspective\n");
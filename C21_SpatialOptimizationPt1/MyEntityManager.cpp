@@ -7,9 +7,14 @@ void MyEntityManager::Init(void)
 	m_uEntityCount = 0;
 	m_mEntityArray = nullptr;
 	m_EntityList.clear();
+	m_pSpatialHash = nullptr;
+	m_uPairCount = 0;
+	m_pPairManager = new MyPairManager();
 }
 void MyEntityManager::Release(void)
 {
+	SafeDelete(m_pSpatialHash);
+	SafeDelete(m_pPairManager);
 	for (uint uEntity = 0; uEntity < m_uEntityCount; ++uEntity)
 	{
 		MyEntity* pEntity = m_EntityList[uEntity];
@@ -168,21 +173,88 @@ MyEntityManager::~MyEntityManager(){Release();};
 // other methods
 void Simplex::MyEntityManager::Update(void)
 {
-	//Clear all collisions
-	for (uint i = 0; i < m_uEntityCount; i++)
+	//the pair manager remembers the pairs of the last update, the rigid bodies only change on begin and end
+	m_pPairManager->BeginFrame();
+
+	//without a grid every pair needs to be checked
+	if (m_pSpatialHash == nullptr)
 	{
-		m_EntityList[i]->ClearCollisionList();
+		m_uPairCount = 0;
+		for (uint i = 0; i + 1 < m_uEntityCount; i++)
+		{
+			for (uint j = i + 1; j < m_uEntityCount; j++)
+			{
+				if (m_mEntityArray[i]->IsColliding(m_mEntityArray[j]))
+					m_pPairManager->AddPair(i, j);
+			}
+			m_uPairCount += m_uEntityCount - i - 1;
+		}
 	}
+	else
+	{
+		//only the entities that share a cell of the grid can be colliding
+		m_pSpatialHash->Update(m_EntityList);
+		std::vector<EntityPair>& lPairList = m_pSpatialHash->GetPairList();
+		m_uPairCount = lPairList.size();
 
-	//check collisions
-	for (uint i = 0; i < m_uEntityCount - 1; i++)
+		//check collisions
+		for (uint i = 0; i < m_uPairCount; i++)
+		{
+			if (m_EntityList[lPairList[i].first]->IsColliding(m_EntityList[lPairList[i].second]))
+				m_pPairManager->AddPair(lPairList[i].first, lPairList[i].second);
+		}
+	}
+
+	m_pPairManager->EndFrame();
+	ApplyPairEvents(0);
+}
+void Simplex::MyEntityManager::ApplyPairEvents(uint a_uFirstEvent)
+{
+	std::vector<PairEvent>& lEventList = m_pPairManager->GetEventList();
+	for (uint i = a_uFirstEvent; i < lEventList.size(); i++)
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		PairEvent& event = lEventList[i];
+		if (event.m_Type == PAIR_STAY)
+			continue;
+
+		MyRigidBody* pRigidBodyA = m_EntityList[event.m_uEntityA]->GetRigidBody();
+		MyRigidBody* pRigidBodyB = m_EntityList[event.m_uEntityB]->GetRigidBody();
+		if (event.m_Type == PAIR_BEGIN)
+		{
+			pRigidBodyA->AddCollisionWith(pRigidBodyB);
+			pRigidBodyB->AddCollisionWith(pRigidBodyA);
+		}
+		else
 		{
-			m_mEntityArray[i]->IsColliding(m_mEntityArray[j]);
+			pRigidBodyA->RemoveCollisionWith(pRigidBodyB);
+			pRigidBodyB->RemoveCollisionWith(pRigidBodyA);
 		}
 	}
 }
+void Simplex::MyEntityManager::UseSpatialHash(bool a_bUse)
+{
+	if (a_bUse && m_pSpatialHash == nullptr)
+	{
+		m_pSpatialHash = new MySpatialHash();
+	}
+	else if (!a_bUse)
+	{
+		SafeDelete(m_pSpatialHash);
+	}
+}
+void Simplex::MyEntityManager::SetCellSize(float a_fCellSize)
+{
+	if (m_pSpatialHash != nullptr)
+		m_pSpatialHash->SetCellSize(a_fCellSize);
+}
+float Simplex::MyEntityManager::GetCellSize(void)
+{
+	if (m_pSpatialHash == nullptr)
+		return 0.0f;
+	return m_pSpatialHash->GetCellSize();
+}
+Simplex::uint Simplex::MyEntityManager::GetPairCount(void) { return m_uPairCount; }
+MyPairManager* Simplex::MyEntityManager::GetPairManager(void) { return m_pPairManager; }
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
 	//Create a temporal entity to store the object
@@ -211,6 +283,11 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//end the collisions of the entity, the pairs of the last one move to its index
+	uint uFirstEvent = m_pPairManager->GetEventList().size();
+	m_pPairManager->RemoveEntity(a_uIndex, m_uEntityCount - 1);
+	ApplyPairEvents(uFirstEvent);
+
 	// if the entity is not the very last we swap it for the last one
 	if (a_uIndex != m_uEntityCount - 1)
 	{
@@ -227,7 +304,7 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	m_mEntityArray = new PEntity[m_EntityList.size()];
 	for (uint i = 0; i < m_EntityList.size(); ++i)
 	{
-		m_mEntityArray[i] = m_mEntityArray[i];
+		m_mEntityArray[i] = m_EntityList[i];
 	}
 	return;
 }
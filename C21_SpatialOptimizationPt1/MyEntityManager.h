@@ -5,7 +5,7 @@ Date: 2017/07
 #ifndef __MYENTITYMANAGER_H_
 #define __MYENTITYMANAGER_H_
 
-#include "MyEntity.h"
+#include "MyPairManager.h"
 
 namespace Simplex
 {
@@ -19,6 +19,10 @@ class MyEntityManager
 	static MyEntityManager* m_pInstance; // Singleton pointer
 	std::vector<MyEntity*> m_EntityList; //entities list
 	PEntity* m_mEntityArray = nullptr; //array of Entity pointers
+
+	MySpatialHash* m_pSpatialHash = nullptr; //grid that tells which pairs to check, nullptr checks all pairs
+	uint m_uPairCount = 0; //number of pairs checked in the last update
+	MyPairManager* m_pPairManager = nullptr; //pairs colliding, tells when they begin and end
 public:
 	/*
 	Usage: Gets the singleton pointer
@@ -236,6 +240,38 @@ public:
 	OUTPUT: shares at least one dimension?
 	*/
 	bool SharesDimension(String a_sUniqueID, MyEntity* const a_pOther);
+	/*
+	USAGE: Turns on or off the spatial hash grid, while on only the entities that share a cell
+	of the grid are checked for collision and their dimensions are not needed
+	ARGUMENTS: bool a_bUse = true -> use the grid?
+	OUTPUT: ---
+	*/
+	void UseSpatialHash(bool a_bUse = true);
+	/*
+	USAGE: Sets the size of the side of the cells of the spatial hash grid
+	ARGUMENTS: float a_fCellSize -> cell size (larger than 0)
+	OUTPUT: ---
+	*/
+	void SetCellSize(float a_fCellSize);
+	/*
+	USAGE: Gets the size of the side of the cells of the spatial hash grid
+	ARGUMENTS: ---
+	OUTPUT: cell size, 0 if the grid is not in use
+	*/
+	float GetCellSize(void);
+	/*
+	USAGE: Gets the number of pairs checked for collision in the last update
+	ARGUMENTS: ---
+	OUTPUT: pair count
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Gets the pair manager, its event list tells which pairs began, stayed or ended colliding
+	in the last update
+	ARGUMENTS: ---
+	OUTPUT: pair manager
+	*/
+	MyPairManager* GetPairManager(void);
 private:
 	/*
 	Usage: constructor
@@ -273,6 +309,12 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	USAGE: Marks the rigid bodies of the pairs that began or ended colliding
+	ARGUMENTS: uint a_uFirstEvent -> first event of the pair manager to apply
+	OUTPUT: ---
+	*/
+	void ApplyPairEvents(uint a_uFirstEvent);
 };//class
 
 } //namespace Simplex
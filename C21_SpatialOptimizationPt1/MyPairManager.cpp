@@ -0,0 +1,248 @@
+#include "MyPairManager.h"
+using namespace Simplex;
+//  MyPairManager
+void MyPairManager::Init(void)
+{
+	PairEntry empty;
+	empty.m_uKey = m_uEmptyKey;
+	m_lEntry.assign(64, empty);
+	m_uCount = 0;
+	m_uFrame = 0;
+	m_lEvent.clear();
+	m_lStale.clear();
+}
+void MyPairManager::Swap(MyPairManager& other)
+{
+	std::swap(m_lEntry, other.m_lEntry);
+	std::swap(m_uCount, other.m_uCount);
+	std::swap(m_uFrame, other.m_uFrame);
+	std::swap(m_lEvent, other.m_lEvent);
+	std::swap(m_lStale, other.m_lStale);
+}
+void MyPairManager::Release(void)
+{
+	m_lEntry.clear();
+	m_uCount = 0;
+	m_lEvent.clear();
+	m_lStale.clear();
+}
+//The big 3
+MyPairManager::MyPairManager(void)
+{
+	Init();
+}
+MyPairManager::MyPairManager(MyPairManager const& other)
+{
+	m_lEntry = other.m_lEntry;
+	m_uCount = other.m_uCount;
+	m_uFrame = other.m_uFrame;
+	m_lEvent = other.m_lEvent;
+	m_lStale = other.m_lStale;
+}
+MyPairManager& MyPairManager::operator=(MyPairManager const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyPairManager temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyPairManager::~MyPairManager() { Release(); };
+//Accessors
+std::vector<PairEvent>& MyPairManager::GetEventList(void) { return m_lEvent; }
+uint MyPairManager::GetPairCount(void) { return m_uCount; }
+//--- Non Standard Singleton Methods
+MyPairManager::PairKey MyPairManager::MakeKey(uint a_uEntityA, uint a_uEntityB)
+{
+	if (a_uEntityA > a_uEntityB)
+		std::swap(a_uEntityA, a_uEntityB);
+	return (static_cast<PairKey>(a_uEntityA) << 32) | a_uEntityB;
+}
+uint MyPairManager::GetHome(PairKey a_uKey)
+{
+	//multiply by a large odd number so the high bits depend on both indices
+	return static_cast<uint>((a_uKey * 0x9E3779B97F4A7C15ull) >> 32) & (m_lEntry.size() - 1);
+}
+int MyPairManager::Find(PairKey a_uKey)
+{
+	uint uMask = m_lEntry.size() - 1;
+	for (uint uSlot = GetHome(a_uKey); ; uSlot = (uSlot + 1) & uMask)
+	{
+		if (m_lEntry[uSlot].m_uKey == a_uKey)
+			return uSlot;
+		if (m_lEntry[uSlot].m_uKey == m_uEmptyKey)
+			return -1;
+	}
+}
+uint MyPairManager::Insert(PairKey a_uKey, uint a_uFrame)
+{
+	//keep at least half of the slots free so the searches stay short
+	if ((m_uCount + 1) * 2 > m_lEntry.size())
+		Grow();
+
+	uint uMask = m_lEntry.size() - 1;
+	uint uSlot = GetHome(a_uKey);
+	while (m_lEntry[uSlot].m_uKey != m_uEmptyKey)
+		uSlot = (uSlot + 1) & uMask;
+
+	m_lEntry[uSlot].m_uKey = a_uKey;
+	m_lEntry[uSlot].m_uFrame = a_uFrame;
+	++m_uCount;
+	return uSlot;
+}
+void MyPairManager::Erase(uint a_uSlot)
+{
+	uint uMask = m_lEntry.size() - 1;
+	uint uHole = a_uSlot;
+	uint uNext = a_uSlot;
+	while (true)
+	{
+		uNext = (uNext + 1) & uMask;
+		PairKey uKey = m_lEntry[uNext].m_uKey;
+		if (uKey == m_uEmptyKey)
+			break;
+
+		//a key can fill the hole if its home is not between the hole and where it is now
+		uint uHome = GetHome(uKey);
+		bool bStays = (uHole <= uNext) ? (uHole < uHome && uHome <= uNext) : (uHole < uHome || uHome <= uNext);
+		if (bStays)
+			continue;
+
+		m_lEntry[uHole] = m_lEntry[uNext];
+		uHole = uNext;
+	}
+	m_lEntry[uHole].m_uKey = m_uEmptyKey;
+	--m_uCount;
+}
+void MyPairManager::Grow(void)
+{
+	std::vector<PairEntry> lOld;
+	std::swap(lOld, m_lEntry);
+
+	PairEntry empty;
+	empty.m_uKey = m_uEmptyKey;
+	m_lEntry.assign(lOld.size() * 2, empty);
+	m_uCount = 0;
+
+	uint uMask = m_lEntry.size() - 1;
+	for (uint i = 0; i < lOld.size(); i++)
+	{
+		if (lOld[i].m_uKey == m_uEmptyKey)
+			continue;
+		uint uSlot = GetHome(lOld[i].m_uKey);
+		while (m_lEntry[uSlot].m_uKey != m_uEmptyKey)
+			uSlot = (uSlot + 1) & uMask;
+		m_lEntry[uSlot] = lOld[i];
+		++m_uCount;
+	}
+}
+void MyPairManager::BeginFrame(void)
+{
+	++m_uFrame;
+	m_lEvent.clear();
+}
+void MyPairManager::AddPair(uint a_uEntityA, uint a_uEntityB)
+{
+	PairKey uKey = MakeKey(a_uEntityA, a_uEntityB);
+
+	PairEvent event;
+	event.m_uEntityA = static_cast<uint>(uKey >> 32);
+	event.m_uEntityB = static_cast<uint>(uKey);
+
+	int nSlot = Find(uKey);
+	if (nSlot < 0)
+	{
+		Insert(uKey, m_uFrame);
+		event.m_Type = PAIR_BEGIN;
+	}
+	else
+	{
+		//already reported this frame
+		if (m_lEntry[nSlot].m_uFrame == m_uFrame)
+			return;
+		m_lEntry[nSlot].m_uFrame = m_uFrame;
+		event.m_Type = PAIR_STAY;
+	}
+	m_lEvent.push_back(event);
+}
+void MyPairManager::EndFrame(void)
+{
+	//the pairs with an old stamp were not reported this frame
+	m_lStale.clear();
+	for (uint i = 0; i < m_lEntry.size(); i++)
+	{
+		if (m_lEntry[i].m_uKey != m_uEmptyKey && m_lEntry[i].m_uFrame != m_uFrame)
+			m_lStale.push_back(m_lEntry[i].m_uKey);
+	}
+
+	//sorted so the end events come in the same order as the pairs
+	std::sort(m_lStale.begin(), m_lStale.end());
+	for (uint i = 0; i < m_lStale.size(); i++)
+	{
+		Erase(Find(m_lStale[i]));
+
+		PairEvent event;
+		event.m_uEntityA = static_cast<uint>(m_lStale[i] >> 32);
+		event.m_uEntityB = static_cast<uint>(m_lStale[i]);
+		event.m_Type = PAIR_END;
+		m_lEvent.push_back(event);
+	}
+}
+void MyPairManager::RemoveEntity(uint a_uIndex, uint a_uLast)
+{
+	//take out every pair of both entities
+	std::vector<PairEntry> lMoved;
+	m_lStale.clear();
+	for (uint i = 0; i < m_lEntry.size(); i++)
+	{
+		PairKey uKey = m_lEntry[i].m_uKey;
+		if (uKey == m_uEmptyKey)
+			continue;
+		uint uA = static_cast<uint>(uKey >> 32);
+		uint uB = static_cast<uint>(uKey);
+		if (uA == a_uIndex || uB == a_uIndex)
+			m_lStale.push_back(uKey);
+		else if (uA == a_uLast || uB == a_uLast)
+			lMoved.push_back(m_lEntry[i]);
+	}
+	for (uint i = 0; i < lMoved.size(); i++)
+		Erase(Find(lMoved[i].m_uKey));
+
+	//the pairs of the removed entity end
+	std::sort(m_lStale.begin(), m_lStale.end());
+	for (uint i = 0; i < m_lStale.size(); i++)
+	{
+		Erase(Find(m_lStale[i]));
+
+		PairEvent event;
+		event.m_uEntityA = static_cast<uint>(m_lStale[i] >> 32);
+		event.m_uEntityB = static_cast<uint>(m_lStale[i]);
+		event.m_Type = PAIR_END;
+		m_lEvent.push_back(event);
+	}
+
+	//the pairs of the last entity go back in with its new index
+	for (uint i = 0; i < lMoved.size(); i++)
+	{
+		uint uA = static_cast<uint>(lMoved[i].m_uKey >> 32);
+		uint uB = static_cast<uint>(lMoved[i].m_uKey);
+		if (uA == a_uLast) uA = a_uIndex;
+		if (uB == a_uLast) uB = a_uIndex;
+		Insert(MakeKey(uA, uB), lMoved[i].m_uFrame);
+	}
+}
+bool MyPairManager::IsColliding(uint a_uEntityA, uint a_uEntityB)
+{
+	return Find(MakeKey(a_uEntityA, a_uEntityB)) >= 0;
+}
+void MyPairManager::Clear(void)
+{
+	PairEntry empty;
+	empty.m_uKey = m_uEmptyKey;
+	std::fill(m_lEntry.begin(), m_lEntry.end(), empty);
+	m_uCount = 0;
+	m_lEvent.clear();
+}
@@ -0,0 +1,199 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYPAIRMANAGER_H_
+#define __MYPAIRMANAGER_H_
+
+#include "MySpatialHash.h"
+
+namespace Simplex
+{
+
+enum PAIR_EVENT
+{
+	PAIR_BEGIN = 0, //the pair started colliding this frame
+	PAIR_STAY = 1, //the pair was already colliding
+	PAIR_END = 2, //the pair stopped colliding (or one of its entities was removed)
+};
+
+struct PairEvent
+{
+	uint m_uEntityA = 0; //index of the first entity in the Entity Manager (the smaller one)
+	uint m_uEntityB = 0; //index of the second entity in the Entity Manager
+	PAIR_EVENT m_Type = PAIR_BEGIN; //what happened to the pair
+};
+
+//System Class
+class MyPairManager
+{
+	typedef unsigned long long PairKey; //smaller index in the high 32 bits, larger one in the low ones
+
+	struct PairEntry
+	{
+		PairKey m_uKey = 0; //pair stored in the slot, m_uEmptyKey if the slot is free
+		uint m_uFrame = 0; //last frame the pair was colliding
+	};
+
+	static const PairKey m_uEmptyKey = ~0ull; //key of the free slots
+
+	std::vector<PairEntry> m_lEntry; //open addressed table, the size is always a power of 2
+	uint m_uCount = 0; //pairs stored in the table
+	uint m_uFrame = 0; //current frame stamp
+
+	std::vector<PairEvent> m_lEvent; //events of the current frame
+	std::vector<PairKey> m_lStale; //pairs to remove at the end of the frame, kept to avoid allocations
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object
+	*/
+	MyPairManager(void);
+	/*
+	USAGE: Copy Constructor
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyPairManager(MyPairManager const& other);
+	/*
+	USAGE: Copy Assignment Operator
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyPairManager& operator=(MyPairManager const& other);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyPairManager(void);
+	/*
+	USAGE: Changes object contents for other object's
+	ARGUMENTS:
+	- MyPairManager& other -> object to swap content from
+	OUTPUT: ---
+	*/
+	void Swap(MyPairManager& other);
+	/*
+	USAGE: Starts a new frame, clears the events of the last one
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void BeginFrame(void);
+	/*
+	USAGE: Reports a pair of entities colliding this frame, adds a begin event if it is new and a
+	stay event if it was colliding last frame, reporting it again in the same frame does nothing
+	ARGUMENTS:
+	- uint a_uEntityA -> index of one entity in the Entity Manager
+	- uint a_uEntityB -> index of the other entity in the Entity Manager
+	OUTPUT: ---
+	*/
+	void AddPair(uint a_uEntityA, uint a_uEntityB);
+	/*
+	USAGE: Ends the frame, the pairs not reported in it are removed with an end event
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void EndFrame(void);
+	/*
+	USAGE: Ends the pairs of an entity the Entity Manager is removing, the pairs of the last entity
+	are moved to its index (the manager swaps them before removing it)
+	ARGUMENTS:
+	- uint a_uIndex -> index of the entity removed
+	- uint a_uLast -> index of the last entity
+	OUTPUT: ---
+	*/
+	void RemoveEntity(uint a_uIndex, uint a_uLast);
+	/*
+	USAGE: Asks if the pair is colliding
+	ARGUMENTS:
+	- uint a_uEntityA -> index of one entity in the Entity Manager
+	- uint a_uEntityB -> index of the other entity in the Entity Manager
+	OUTPUT: are they colliding?
+	*/
+	bool IsColliding(uint a_uEntityA, uint a_uEntityB);
+	/*
+	USAGE: Gets the events of the current frame, begins and stays in the order the pairs were
+	reported followed by the ends
+	ARGUMENTS: ---
+	OUTPUT: list of events
+	*/
+	std::vector<PairEvent>& GetEventList(void);
+	/*
+	USAGE: Gets the number of pairs colliding
+	ARGUMENTS: ---
+	OUTPUT: pair count
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Removes all the pairs without events
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+
+private:
+	/*
+	USAGE: Deallocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Release(void);
+	/*
+	USAGE: Allocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Makes the key of a pair, the same for both orders
+	ARGUMENTS:
+	- uint a_uEntityA -> index of one entity
+	- uint a_uEntityB -> index of the other entity
+	OUTPUT: key
+	*/
+	static PairKey MakeKey(uint a_uEntityA, uint a_uEntityB);
+	/*
+	USAGE: Gets the slot where the search for a key starts
+	ARGUMENTS: PairKey a_uKey -> key
+	OUTPUT: slot
+	*/
+	uint GetHome(PairKey a_uKey);
+	/*
+	USAGE: Finds the slot of a key
+	ARGUMENTS: PairKey a_uKey -> key
+	OUTPUT: slot of the key, -1 if it is not in the table
+	*/
+	int Find(PairKey a_uKey);
+	/*
+	USAGE: Adds a key that is not in the table, growing it if it gets half full
+	ARGUMENTS:
+	- PairKey a_uKey -> key
+	- uint a_uFrame -> frame stamp of the pair
+	OUTPUT: slot of the key
+	*/
+	uint Insert(PairKey a_uKey, uint a_uFrame);
+	/*
+	USAGE: Frees a slot, moving back the keys after it so no search stops early
+	ARGUMENTS: uint a_uSlot -> slot to free
+	OUTPUT: ---
+	*/
+	void Erase(uint a_uSlot);
+	/*
+	USAGE: Makes the table twice as big and places the keys again
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Grow(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYPAIRMANAGER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -26,7 +26,7 @@ void MyRigidBody::Init(void)
 
 	m_m4ToWorld = IDENTITY_M4;
 
-	m_nCollidingSetSize = 0;
+	m_lCollidingList.clear();
 }
 void MyRigidBody::Swap(MyRigidBody& other)
 {
@@ -53,8 +53,7 @@ void MyRigidBody::Swap(MyRigidBody& other)
 
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
 
-	std::swap(m_nCollidingSetSize, other.m_nCollidingSetSize);
-	std::swap(m_CollidingRBSet, other.m_CollidingRBSet);
+	std::swap(m_lCollidingList, other.m_lCollidingList);
 }
 void MyRigidBody::Release(void)
 {
@@ -197,8 +196,7 @@ MyRigidBody::MyRigidBody(MyRigidBody const& other)
 
 	m_m4ToWorld = other.m_m4ToWorld;
 
-	m_nCollidingSetSize = other.m_nCollidingSetSize;
-	m_CollidingRBSet = other.m_CollidingRBSet;
+	m_lCollidingList = other.m_lCollidingList;
 }
 MyRigidBody& MyRigidBody::operator=(MyRigidBody const& other)
 {
@@ -215,39 +213,32 @@ MyRigidBody::~MyRigidBody() { Release(); };
 //--- other Methods
 void MyRigidBody::AddCollisionWith(MyRigidBody* other)
 {
-	/*
-		check if the object is already in the colliding set, if
-		the object is already there return with no changes
-	*/
-	auto element = m_CollidingRBSet.find(other);
-	if (element != m_CollidingRBSet.end())
+	//if the object is already in the colliding list return with no changes
+	if (IsInCollidingList(other))
 		return;
-	// we couldn't find the object so add it
-	m_CollidingRBSet.insert(other);
-	m_nCollidingSetSize = m_CollidingRBSet.size();
+	m_lCollidingList.push_back(other);
 }
 void MyRigidBody::RemoveCollisionWith(MyRigidBody* other)
 {
-	//if the set is empty there is no need to remove
-	if (0 == m_nCollidingSetSize)
-		return;
-
-	/*
-		Special note, even though erase will not break if we try to
-		erase a non existing rigid body from the set, checking first
-		improves the performance.
-	*/
-
-	//Check if we have the object in the set first
-	if(m_CollidingRBSet.find(other)!= m_CollidingRBSet.end())
-		m_CollidingRBSet.erase(other);//remove from set
-
-	m_nCollidingSetSize = m_CollidingRBSet.size();
+	//the order does not matter, the last one takes its place
+	for (uint i = 0; i < m_lCollidingList.size(); i++)
+	{
+		if (m_lCollidingList[i] == other)
+		{
+			m_lCollidingList[i] = m_lCollidingList.back();
+			m_lCollidingList.pop_back();
+			return;
+		}
+	}
 }
+bool MyRigidBody::IsInCollidingList(MyRigidBody* const other)
+{
+	return std::find(m_lCollidingList.begin(), m_lCollidingList.end(), other) != m_lCollidingList.end();
+}
+uint MyRigidBody::GetCollidingCount(void) { return m_lCollidingList.size(); }
 void MyRigidBody::ClearCollidingList(void)
 {
-	m_CollidingRBSet.clear();
-	m_nCollidingSetSize = 0;
+	m_lCollidingList.clear();
 }
 uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
 {
@@ -280,21 +271,6 @@ bool MyRigidBody::IsColliding(MyRigidBody* const other)
 		if (this->m_v3MinG.z > other->m_v3MaxG.z) //this in front of other
 			bColliding = false;
 
-		if (bColliding) //they are colliding with bounding box also
-		{
-			this->AddCollisionWith(other);
-			other->AddCollisionWith(this);
-		}
-		else //they are not colliding with bounding box
-		{
-			this->RemoveCollisionWith(other);
-			other->RemoveCollisionWith(this);
-		}
-	}
-	else //they are not colliding with bounding sphere
-	{
-		this->RemoveCollisionWith(other);
-		other->RemoveCollisionWith(this);
 	}
 	return bColliding;
 }
@@ -303,21 +279,21 @@ void MyRigidBody::AddToRenderList(void)
 {
 	if (m_bVisibleBS)
 	{
-		if (m_CollidingRBSet.size() > 0)
+		if (m_lCollidingList.size() > 0)
 			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 		else
 			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 	}
 	if (m_bVisibleOBB)
 	{
-		if (m_CollidingRBSet.size() > 0)
+		if (m_lCollidingList.size() > 0)
 			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorColliding);
 		else
 			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorNotColliding);
 	}
 	if (m_bVisibleARBB)
 	{
-		if (m_CollidingRBSet.size() > 0)
+		if (m_lCollidingList.size() > 0)
 			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
 		else
 			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
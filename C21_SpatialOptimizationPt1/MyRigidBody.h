@@ -38,8 +38,7 @@ class MyRigidBody
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Matrix that will take us from local to world coordinate
 
-	uint m_nCollidingSetSize = 0; //size of the colliding set
-	std::set<MyRigidBody*> m_CollidingRBSet; //set of rigid bodies this one is colliding with
+	std::vector<MyRigidBody*> m_lCollidingList; //rigid bodies this one is colliding with, only a handful
 
 public:
 	/*
@@ -88,21 +87,35 @@ public:
 	void ClearCollidingList(void);
 
 	/*
-	USAGE: Mark collision with the incoming Rigid Body
+	USAGE: Mark collision with the incoming Rigid Body, the pair manager calls it once when the pair begins
 	ARGUMENTS: MyRigidBody* other -> inspected rigid body
 	OUTPUT: ---
 	*/
 	void AddCollisionWith(MyRigidBody* other);
 
 	/*
-	USAGE: Remove marked collision with the incoming Rigid Body
+	USAGE: Remove marked collision with the incoming Rigid Body, the pair manager calls it once when the pair ends
 	ARGUMENTS: MyRigidBody* other -> inspected rigid body
 	OUTPUT: ---
 	*/
 	void RemoveCollisionWith(MyRigidBody* other);
 
 	/*
-	USAGE: Tells if the object is colliding with the incoming one
+	USAGE: Asks if the collision with the incoming Rigid Body is marked
+	ARGUMENTS: MyRigidBody* const other -> inspected rigid body
+	OUTPUT: is it in the colliding list?
+	*/
+	bool IsInCollidingList(MyRigidBody* const other);
+
+	/*
+	USAGE: Gets the number of rigid bodies this one is marked as colliding with
+	ARGUMENTS: ---
+	OUTPUT: colliding count
+	*/
+	uint GetCollidingCount(void);
+
+	/*
+	USAGE: Tells if the object is colliding with the incoming one, the pair manager keeps track of the result
 	ARGUMENTS: MyRigidBody* const other -> inspected rigid body
 	OUTPUT: are they colliding?
 	*/
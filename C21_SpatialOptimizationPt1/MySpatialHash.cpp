@@ -0,0 +1,171 @@
+#include "MySpatialHash.h"
+using namespace Simplex;
+//  MySpatialHash
+void MySpatialHash::Init(void)
+{
+	m_fCellSize = 10.0f;
+	m_lCellMin.clear();
+	m_lCellMax.clear();
+	m_uBucketCount = 0;
+	m_lBucketStart.clear();
+	m_lEntry.clear();
+	m_lPairList.clear();
+}
+void MySpatialHash::Swap(MySpatialHash& other)
+{
+	std::swap(m_fCellSize, other.m_fCellSize);
+	std::swap(m_lCellMin, other.m_lCellMin);
+	std::swap(m_lCellMax, other.m_lCellMax);
+	std::swap(m_uBucketCount, other.m_uBucketCount);
+	std::swap(m_lBucketStart, other.m_lBucketStart);
+	std::swap(m_lEntry, other.m_lEntry);
+	std::swap(m_lPairList, other.m_lPairList);
+}
+void MySpatialHash::Release(void)
+{
+	m_lCellMin.clear();
+	m_lCellMax.clear();
+	m_uBucketCount = 0;
+	m_lBucketStart.clear();
+	m_lEntry.clear();
+	m_lPairList.clear();
+}
+//The big 3
+MySpatialHash::MySpatialHash(float a_fCellSize)
+{
+	Init();
+	SetCellSize(a_fCellSize);
+}
+MySpatialHash::MySpatialHash(MySpatialHash const& other)
+{
+	m_fCellSize = other.m_fCellSize;
+	m_lCellMin = other.m_lCellMin;
+	m_lCellMax = other.m_lCellMax;
+	m_uBucketCount = other.m_uBucketCount;
+	m_lBucketStart = other.m_lBucketStart;
+	m_lEntry = other.m_lEntry;
+	m_lPairList = other.m_lPairList;
+}
+MySpatialHash& MySpatialHash::operator=(MySpatialHash const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MySpatialHash temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MySpatialHash::~MySpatialHash() { Release(); };
+//Accessors
+float MySpatialHash::GetCellSize(void) { return m_fCellSize; }
+void MySpatialHash::SetCellSize(float a_fCellSize)
+{
+	//a cell needs some size, otherwise every entity would be in infinite cells
+	if (a_fCellSize > 0.0f)
+		m_fCellSize = a_fCellSize;
+}
+std::vector<EntityPair>& MySpatialHash::GetPairList(void) { return m_lPairList; }
+uint MySpatialHash::GetEntryCount(void) { return m_lEntry.size(); }
+//--- Non Standard Singleton Methods
+uint MySpatialHash::GetBucket(int a_nX, int a_nY, int a_nZ)
+{
+	//large primes mixed together so neighbor cells land in different buckets
+	uint uHash = (static_cast<uint>(a_nX) * 73856093u) ^
+		(static_cast<uint>(a_nY) * 19349663u) ^
+		(static_cast<uint>(a_nZ) * 83492791u);
+	return uHash & (m_uBucketCount - 1);
+}
+void MySpatialHash::Update(std::vector<MyEntity*> const& a_lEntityList)
+{
+	uint uEntityCount = a_lEntityList.size();
+	m_lPairList.clear();
+
+	//find the range of cells each entity touches and how many entries that makes
+	m_lCellMin.resize(uEntityCount * 3);
+	m_lCellMax.resize(uEntityCount * 3);
+	uint uEntryCount = 0;
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		MyRigidBody* pRigidBody = a_lEntityList[i]->GetRigidBody();
+		vector3 v3Min = pRigidBody->GetMinGlobal() / m_fCellSize;
+		vector3 v3Max = pRigidBody->GetMaxGlobal() / m_fCellSize;
+		uint uCells = 1;
+		for (uint uAxis = 0; uAxis < 3; uAxis++)
+		{
+			m_lCellMin[i * 3 + uAxis] = static_cast<int>(std::floor(v3Min[uAxis]));
+			m_lCellMax[i * 3 + uAxis] = static_cast<int>(std::floor(v3Max[uAxis]));
+			uCells *= m_lCellMax[i * 3 + uAxis] - m_lCellMin[i * 3 + uAxis] + 1;
+		}
+		uEntryCount += uCells;
+	}
+
+	//at least as many buckets as entries so most buckets hold a single cell
+	m_uBucketCount = 1;
+	while (m_uBucketCount < uEntryCount)
+		m_uBucketCount <<= 1;
+
+	//count the entries of each bucket, then add the counts so each bucket knows where it ends
+	m_lBucketStart.assign(m_uBucketCount + 1, 0);
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		int* nMin = &m_lCellMin[i * 3];
+		int* nMax = &m_lCellMax[i * 3];
+		for (int x = nMin[0]; x <= nMax[0]; x++)
+			for (int y = nMin[1]; y <= nMax[1]; y++)
+				for (int z = nMin[2]; z <= nMax[2]; z++)
+					++m_lBucketStart[GetBucket(x, y, z)];
+	}
+	for (uint i = 1; i <= m_uBucketCount; i++)
+	{
+		m_lBucketStart[i] += m_lBucketStart[i - 1];
+	}
+
+	//fill the buckets from their end, once done every bucket points to its first entry
+	m_lEntry.resize(uEntryCount);
+	for (uint i = 0; i < uEntityCount; i++)
+	{
+		int* nMin = &m_lCellMin[i * 3];
+		int* nMax = &m_lCellMax[i * 3];
+		for (int x = nMin[0]; x <= nMax[0]; x++)
+			for (int y = nMin[1]; y <= nMax[1]; y++)
+				for (int z = nMin[2]; z <= nMax[2]; z++)
+				{
+					CellEntry& entry = m_lEntry[--m_lBucketStart[GetBucket(x, y, z)]];
+					entry.m_uEntity = i;
+					entry.m_nX = x;
+					entry.m_nY = y;
+					entry.m_nZ = z;
+				}
+	}
+
+	//entities in the same cell are candidates, but two entities can share many cells
+	//so the pair is only reported by the first cell both of them are in
+	for (uint uBucket = 0; uBucket < m_uBucketCount; uBucket++)
+	{
+		uint uEnd = m_lBucketStart[uBucket + 1];
+		for (uint a = m_lBucketStart[uBucket]; a < uEnd; a++)
+		{
+			CellEntry& entryA = m_lEntry[a];
+			int* nMinA = &m_lCellMin[entryA.m_uEntity * 3];
+			for (uint b = a + 1; b < uEnd; b++)
+			{
+				CellEntry& entryB = m_lEntry[b];
+				//different cells can end up in the same bucket
+				if (entryA.m_nX != entryB.m_nX || entryA.m_nY != entryB.m_nY || entryA.m_nZ != entryB.m_nZ)
+					continue;
+
+				int* nMinB = &m_lCellMin[entryB.m_uEntity * 3];
+				if (entryA.m_nX != std::max(nMinA[0], nMinB[0]) ||
+					entryA.m_nY != std::max(nMinA[1], nMinB[1]) ||
+					entryA.m_nZ != std::max(nMinA[2], nMinB[2]))
+					continue;
+
+				m_lPairList.push_back(EntityPair(
+					std::min(entryA.m_uEntity, entryB.m_uEntity),
+					std::max(entryA.m_uEntity, entryB.m_uEntity)));
+			}
+		}
+	}
+}
\ No newline at end of file
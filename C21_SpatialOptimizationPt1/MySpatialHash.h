@@ -0,0 +1,132 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYSPATIALHASH_H_
+#define __MYSPATIALHASH_H_
+
+#include "MyEntity.h"
+
+namespace Simplex
+{
+
+typedef std::pair<uint, uint> EntityPair; //pair of indices in the Entity Manager
+
+//System Class
+class MySpatialHash
+{
+	struct CellEntry
+	{
+		uint m_uEntity = 0; //index of the entity in the list
+		int m_nX = 0; //cell coordinates
+		int m_nY = 0;
+		int m_nZ = 0;
+	};
+
+	float m_fCellSize = 10.0f; //size of the side of each cell of the grid
+
+	std::vector<int> m_lCellMin; //first cell of each entity (3 ints per entity)
+	std::vector<int> m_lCellMax; //last cell of each entity (3 ints per entity)
+
+	uint m_uBucketCount = 0; //number of buckets (always a power of 2)
+	std::vector<uint> m_lBucketStart; //first entry of each bucket, the last one is the entry count
+	std::vector<CellEntry> m_lEntry; //entries of all the buckets, one after the other
+
+	std::vector<EntityPair> m_lPairList; //candidate pairs found in the last update
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: float a_fCellSize = 10.0f -> size of the side of each cell
+	OUTPUT: class object
+	*/
+	MySpatialHash(float a_fCellSize = 10.0f);
+	/*
+	USAGE: Copy Constructor
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MySpatialHash(MySpatialHash const& other);
+	/*
+	USAGE: Copy Assignment Operator
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MySpatialHash& operator=(MySpatialHash const& other);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MySpatialHash(void);
+	/*
+	USAGE: Changes object contents for other object's
+	ARGUMENTS:
+	- MySpatialHash& other -> object to swap content from
+	OUTPUT: ---
+	*/
+	void Swap(MySpatialHash& other);
+	/*
+	USAGE: Gets the size of the side of the cells
+	ARGUMENTS: ---
+	OUTPUT: cell size
+	*/
+	float GetCellSize(void);
+	/*
+	USAGE: Sets the size of the side of the cells, used on the next update
+	ARGUMENTS: float a_fCellSize -> cell size (larger than 0)
+	OUTPUT: ---
+	*/
+	void SetCellSize(float a_fCellSize);
+	/*
+	USAGE: Puts every entity in the buckets of the cells its global bounding box touches and
+	makes the list of the pairs that share a cell, each pair is only reported once
+	ARGUMENTS: std::vector<MyEntity*> const& a_lEntityList -> entities to sort
+	OUTPUT: ---
+	*/
+	void Update(std::vector<MyEntity*> const& a_lEntityList);
+	/*
+	USAGE: Gets the candidate pairs found in the last update
+	ARGUMENTS: ---
+	OUTPUT: list of pairs of indices in the entity list, first is always the smaller one
+	*/
+	std::vector<EntityPair>& GetPairList(void);
+	/*
+	USAGE: Gets the number of entries stored in the buckets in the last update
+	ARGUMENTS: ---
+	OUTPUT: entry count
+	*/
+	uint GetEntryCount(void);
+
+private:
+	/*
+	USAGE: Deallocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Release(void);
+	/*
+	USAGE: Allocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets the bucket of a cell
+	ARGUMENTS:
+	- int a_nX -> cell coordinate in x
+	- int a_nY -> cell coordinate in y
+	- int a_nZ -> cell coordinate in z
+	OUTPUT: index of the bucket
+	*/
+	uint GetBucket(int a_nX, int a_nY, int a_nZ);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSPATIALHASH_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "AppClass.h"
+#include "MyThreadPool.h"
 using namespace Simplex;
 void Application::InitVariables(void)
 {
@@ -12,8 +13,14 @@ void Application::InitVariables(void)
 
 	m_pEntityMngr->AddEntity("Minecraft\\Steve.obj", "Steve");
 	m_pEntityMngr->UsePhysicsSolver();
+	m_pEntityMngr->UseConvexHull();
+	m_pEntityMngr->SetContinuous();
+
+	//room for the bodies of Steve and all the cubes
+	uint uCubeCount = 100;
+	MyPhysicsWorld::GetInstance()->Reserve(m_pEntityMngr->GetEntityCount() + uCubeCount);
 	
-	for (int i = 0; i < 100; i++)
+	for (uint i = 0; i < uCubeCount; i++)
 	{
 		m_pEntityMngr->AddEntity("Minecraft\\Cube.obj", "Cube_" + std::to_string(i));
 		vector3 v3Position = vector3(glm::sphericalRand(12.0f));
@@ -25,6 +32,14 @@ void Application::InitVariables(void)
 
 		//m_pEntityMngr->SetMass(i+1);
 	}
+	//only check the pairs whose fat boxes overlap
+	m_pEntityMngr->UseDynamicTree();
+
+	//physics at 60 steps per second whatever the frame rate is
+	m_pEntityMngr->UseFixedStep();
+
+	//impulses on the velocities, SOLVER_POSITION projects the positions over substeps instead
+	m_pEntityMngr->SetSolverMode(SOLVER_IMPULSE);
 }
 void Application::Update(void)
 {
@@ -72,6 +87,15 @@ void Application::Release(void)
 	//Release MyEntityManager
 	MyEntityManager::ReleaseInstance();
 
+	//Release the physics world once the entities gave their bodies back
+	MyPhysicsWorld::ReleaseInstance();
+
+	//Release the threads the physics world solved its islands on
+	MyThreadPool::ReleaseInstance();
+
+	//Release the convex hulls the rigid bodies were sharing
+	MyConvexHull::ReleaseHulls();
+
 	//release GUI
 	ShutdownGUI();
 }
\ No newline at end of file
@@ -38,6 +38,10 @@ void Application::DrawGUI(void)
 			ImGui::TextColored(v4Color, m_sProgrammer.c_str());
 			ImGui::Text("FrameRate: %.2f [FPS] -> %.3f [ms/frame]\n",
 				ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+			ImGui::Text("Pairs checked: %d\n", m_pEntityMngr->GetPairCount());
+			ImGui::Text("Contacts: %d\n", m_pEntityMngr->GetContactCount());
+			ImGui::Text("Sleeping: %d\n", m_pEntityMngr->GetSleepingCount());
+			ImGui::Text("Physics steps: %d\n", m_pEntityMngr->GetStepCount());
 			ImGui::Separator();
 			ImGui::Text("Control:\n");
 			ImGui::Text("   WASD: Movement\n");
@@ -0,0 +1,336 @@
+#include "MyConvexHull.h"
+using namespace Simplex;
+//  MyConvexHull
+std::map<String, MyConvexHull*> MyConvexHull::m_HullMap;
+void MyConvexHull::Init(void)
+{
+	m_lVertex.clear();
+	m_lIndex.clear();
+}
+void MyConvexHull::Swap(MyConvexHull& other)
+{
+	std::swap(m_lVertex, other.m_lVertex);
+	std::swap(m_lIndex, other.m_lIndex);
+}
+void MyConvexHull::Release(void)
+{
+	m_lVertex.clear();
+	m_lIndex.clear();
+}
+//The big 3
+MyConvexHull::MyConvexHull(std::vector<vector3> const& a_lPointList)
+{
+	Init();
+	Build(a_lPointList);
+}
+MyConvexHull::MyConvexHull(MyConvexHull const& other)
+{
+	m_lVertex = other.m_lVertex;
+	m_lIndex = other.m_lIndex;
+}
+MyConvexHull& MyConvexHull::operator=(MyConvexHull const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyConvexHull temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyConvexHull::~MyConvexHull() { Release(); };
+//Accessors
+std::vector<vector3> MyConvexHull::GetVertexList(void) { return m_lVertex; }
+uint MyConvexHull::GetTriangleCount(void) { return m_lIndex.size() / 3; }
+//--- Non Standard Singleton Methods
+MyConvexHull* MyConvexHull::GetHull(Model* a_pModel)
+{
+	if (a_pModel == nullptr)
+		return nullptr;
+
+	String sName = a_pModel->GetName();
+	if (sName == "")
+		return nullptr;
+
+	//built already by another entity with the same model
+	std::map<String, MyConvexHull*>::iterator it = m_HullMap.find(sName);
+	if (it != m_HullMap.end())
+		return it->second;
+
+	MyConvexHull* pHull = new MyConvexHull(a_pModel->GetVertexList());
+	m_HullMap[sName] = pHull;
+	return pHull;
+}
+void MyConvexHull::ReleaseHulls(void)
+{
+	for (std::map<String, MyConvexHull*>::iterator it = m_HullMap.begin(); it != m_HullMap.end(); ++it)
+	{
+		delete it->second;
+	}
+	m_HullMap.clear();
+}
+vector3 MyConvexHull::GetSupport(vector3 a_v3Direction)
+{
+	if (m_lVertex.empty())
+		return ZERO_V3;
+
+	uint uBest = 0;
+	float fBest = glm::dot(m_lVertex[0], a_v3Direction);
+	for (uint i = 1; i < m_lVertex.size(); i++)
+	{
+		float fDistance = glm::dot(m_lVertex[i], a_v3Direction);
+		if (fDistance > fBest)
+		{
+			fBest = fDistance;
+			uBest = i;
+		}
+	}
+	return m_lVertex[uBest];
+}
+void MyConvexHull::Build(std::vector<vector3> const& a_lPointList)
+{
+	std::vector<vector3> const& lPoint = a_lPointList;
+	uint uCount = lPoint.size();
+	if (uCount == 0)
+		return;
+
+	//extreme points along each axis
+	uint uMin[3] = { 0, 0, 0 };
+	uint uMax[3] = { 0, 0, 0 };
+	for (uint i = 1; i < uCount; i++)
+	{
+		for (uint k = 0; k < 3; k++)
+		{
+			if (lPoint[i][k] < lPoint[uMin[k]][k]) uMin[k] = i;
+			if (lPoint[i][k] > lPoint[uMax[k]][k]) uMax[k] = i;
+		}
+	}
+
+	//points closer than this to a plane are on it, relative to the size of the model
+	float fEpsilon = 0.0f;
+	for (uint k = 0; k < 3; k++)
+		fEpsilon += lPoint[uMax[k]][k] - lPoint[uMin[k]][k];
+	fEpsilon *= 0.00001f;
+
+	//the two extremes that are the furthest apart
+	uint uA = uMin[0];
+	uint uB = uMax[0];
+	for (uint k = 1; k < 3; k++)
+	{
+		if (glm::distance(lPoint[uMin[k]], lPoint[uMax[k]]) > glm::distance(lPoint[uA], lPoint[uB]))
+		{
+			uA = uMin[k];
+			uB = uMax[k];
+		}
+	}
+	if (glm::distance(lPoint[uA], lPoint[uB]) <= fEpsilon)
+	{
+		m_lVertex.push_back(lPoint[uA]);
+		return;
+	}
+
+	//the point furthest from their line
+	vector3 v3Line = glm::normalize(lPoint[uB] - lPoint[uA]);
+	uint uC = uA;
+	float fFar = 0.0f;
+	for (uint i = 0; i < uCount; i++)
+	{
+		vector3 v3Offset = lPoint[i] - lPoint[uA];
+		float fDistance = glm::length(v3Offset - v3Line * glm::dot(v3Offset, v3Line));
+		if (fDistance > fFar)
+		{
+			fFar = fDistance;
+			uC = i;
+		}
+	}
+	if (fFar <= fEpsilon)
+	{
+		m_lVertex.push_back(lPoint[uA]);
+		m_lVertex.push_back(lPoint[uB]);
+		return;
+	}
+
+	//the point furthest from their plane
+	vector3 v3Plane = glm::normalize(glm::cross(lPoint[uB] - lPoint[uA], lPoint[uC] - lPoint[uA]));
+	uint uD = uA;
+	fFar = 0.0f;
+	for (uint i = 0; i < uCount; i++)
+	{
+		float fDistance = glm::abs(glm::dot(lPoint[i] - lPoint[uA], v3Plane));
+		if (fDistance > fFar)
+		{
+			fFar = fDistance;
+			uD = i;
+		}
+	}
+	if (fFar <= fEpsilon)
+	{
+		//flat, the support of all the points is still right
+		m_lVertex = lPoint;
+		return;
+	}
+
+	std::vector<HullFace> lFace;
+	std::map<std::pair<uint, uint>, uint> mEdge; //face on the left of each directed edge, to walk to the neighbors
+	uint uTetrahedron[4][4] = { { uA, uB, uC, uD }, { uA, uB, uD, uC }, { uA, uC, uD, uB }, { uB, uC, uD, uA } };
+	for (uint f = 0; f < 4; f++)
+	{
+		HullFace face;
+		face.m_uVertex[0] = uTetrahedron[f][0];
+		face.m_uVertex[1] = uTetrahedron[f][1];
+		face.m_uVertex[2] = uTetrahedron[f][2];
+		vector3 v3Normal = glm::normalize(glm::cross(lPoint[face.m_uVertex[1]] - lPoint[face.m_uVertex[0]],
+			lPoint[face.m_uVertex[2]] - lPoint[face.m_uVertex[0]]));
+
+		//turn it to face away from the fourth point
+		if (glm::dot(v3Normal, lPoint[uTetrahedron[f][3]] - lPoint[face.m_uVertex[0]]) > 0.0f)
+		{
+			std::swap(face.m_uVertex[1], face.m_uVertex[2]);
+			v3Normal = -v3Normal;
+		}
+		face.m_v3Normal = v3Normal;
+		face.m_fOffset = glm::dot(v3Normal, lPoint[face.m_uVertex[0]]);
+		for (uint e = 0; e < 3; e++)
+			mEdge[std::pair<uint, uint>(face.m_uVertex[e], face.m_uVertex[(e + 1) % 3])] = f;
+		lFace.push_back(face);
+	}
+
+	//every point goes to the first face it is above
+	for (uint i = 0; i < uCount; i++)
+	{
+		if (i == uA || i == uB || i == uC || i == uD)
+			continue;
+		for (uint f = 0; f < lFace.size(); f++)
+		{
+			if (glm::dot(lFace[f].m_v3Normal, lPoint[i]) - lFace[f].m_fOffset > fEpsilon)
+			{
+				lFace[f].m_lOutside.push_back(i);
+				break;
+			}
+		}
+	}
+
+	//the new faces go at the end of the list so they are processed in the same loop
+	std::vector<uint> lVisible;
+	std::vector<std::pair<uint, uint>> lHorizon;
+	std::vector<uint> lOrphan;
+	for (uint f = 0; f < lFace.size(); f++)
+	{
+		if (!lFace[f].m_bAlive || lFace[f].m_lOutside.empty())
+			continue;
+
+		//the point of the face that is the furthest out
+		uint uEye = lFace[f].m_lOutside[0];
+		fFar = -1.0f;
+		for (uint i = 0; i < lFace[f].m_lOutside.size(); i++)
+		{
+			uint uPoint = lFace[f].m_lOutside[i];
+			float fDistance = glm::dot(lFace[f].m_v3Normal, lPoint[uPoint]) - lFace[f].m_fOffset;
+			if (fDistance > fFar)
+			{
+				fFar = fDistance;
+				uEye = uPoint;
+			}
+		}
+
+		//walk from this face to the neighbors the point is above, the edges to the ones it is not above
+		//are the horizon, walking keeps the visible faces in one piece and taking the neighbors the point
+		//is barely above keeps the new faces from folding in when points are almost coplanar
+		lVisible.clear();
+		lHorizon.clear();
+		lFace[f].m_bVisible = true;
+		lVisible.push_back(f);
+		for (uint v = 0; v < lVisible.size(); v++)
+		{
+			HullFace& face = lFace[lVisible[v]];
+			for (uint e = 0; e < 3; e++)
+			{
+				std::pair<uint, uint> edge(face.m_uVertex[e], face.m_uVertex[(e + 1) % 3]);
+				std::map<std::pair<uint, uint>, uint>::iterator it = mEdge.find(std::pair<uint, uint>(edge.second, edge.first));
+				if (it == mEdge.end())
+				{
+					//the surface is not closed anymore, the support of all the points is still right
+					m_lVertex = lPoint;
+					return;
+				}
+				uint uNeighbor = it->second;
+				HullFace& neighbor = lFace[uNeighbor];
+				if (neighbor.m_bVisible)
+					continue;
+				if (glm::dot(neighbor.m_v3Normal, lPoint[uEye]) - neighbor.m_fOffset > 0.0f)
+				{
+					neighbor.m_bVisible = true;
+					lVisible.push_back(uNeighbor);
+				}
+				else
+					lHorizon.push_back(edge);
+			}
+		}
+
+		lOrphan.clear();
+		for (uint v = 0; v < lVisible.size(); v++)
+		{
+			HullFace& face = lFace[lVisible[v]];
+			for (uint i = 0; i < face.m_lOutside.size(); i++)
+			{
+				if (face.m_lOutside[i] != uEye)
+					lOrphan.push_back(face.m_lOutside[i]);
+			}
+			for (uint e = 0; e < 3; e++)
+				mEdge.erase(std::pair<uint, uint>(face.m_uVertex[e], face.m_uVertex[(e + 1) % 3]));
+			face.m_lOutside.clear();
+			face.m_bAlive = false;
+		}
+
+		//close the hole with faces from the horizon to the point, same winding as the faces they replace
+		uint uFirstNew = lFace.size();
+		for (uint e = 0; e < lHorizon.size(); e++)
+		{
+			HullFace face;
+			face.m_uVertex[0] = lHorizon[e].first;
+			face.m_uVertex[1] = lHorizon[e].second;
+			face.m_uVertex[2] = uEye;
+			vector3 v3Normal = glm::cross(lPoint[face.m_uVertex[1]] - lPoint[face.m_uVertex[0]],
+				lPoint[face.m_uVertex[2]] - lPoint[face.m_uVertex[0]]);
+			float fLength = glm::length(v3Normal);
+			face.m_v3Normal = fLength > 0.0f ? v3Normal / fLength : ZERO_V3;
+			face.m_fOffset = glm::dot(face.m_v3Normal, lPoint[face.m_uVertex[0]]);
+			for (uint k = 0; k < 3; k++)
+				mEdge[std::pair<uint, uint>(face.m_uVertex[k], face.m_uVertex[(k + 1) % 3])] = lFace.size();
+			lFace.push_back(face);
+		}
+
+		//the points that were outside the old faces go to the new ones or are inside the hull now
+		for (uint i = 0; i < lOrphan.size(); i++)
+		{
+			for (uint g = uFirstNew; g < lFace.size(); g++)
+			{
+				if (glm::dot(lFace[g].m_v3Normal, lPoint[lOrphan[i]]) - lFace[g].m_fOffset > fEpsilon)
+				{
+					lFace[g].m_lOutside.push_back(lOrphan[i]);
+					break;
+				}
+			}
+		}
+	}
+
+	//keep only the points used by the faces left
+	std::map<uint, uint> mRemap;
+	for (uint f = 0; f < lFace.size(); f++)
+	{
+		if (!lFace[f].m_bAlive)
+			continue;
+		for (uint e = 0; e < 3; e++)
+		{
+			uint uPoint = lFace[f].m_uVertex[e];
+			std::map<uint, uint>::iterator it = mRemap.find(uPoint);
+			if (it == mRemap.end())
+			{
+				it = mRemap.insert(std::pair<uint, uint>(uPoint, m_lVertex.size())).first;
+				m_lVertex.push_back(lPoint[uPoint]);
+			}
+			m_lIndex.push_back(it->second);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYCONVEXHULL_H_
+#define __MYCONVEXHULL_H_
+
+#include "Simplex\Mesh\Model.h"
+
+namespace Simplex
+{
+
+//System Class
+class MyConvexHull
+{
+	struct HullFace
+	{
+		uint m_uVertex[3]; //vertices of the triangle, counter clockwise seen from outside
+		vector3 m_v3Normal = ZERO_V3; //normal pointing out of the hull
+		float m_fOffset = 0.0f; //distance of the plane of the face to the origin along the normal
+		std::vector<uint> m_lOutside; //points above the face that are not in the hull yet
+		bool m_bAlive = true; //false once the face has been replaced
+		bool m_bVisible = false; //seen from the point being added, it is about to be replaced
+	};
+
+	std::vector<vector3> m_lVertex; //vertices of the hull in model space
+	std::vector<uint> m_lIndex; //three vertices per triangle of the hull
+
+	static std::map<String, MyConvexHull*> m_HullMap; //hulls already built, by name of the model
+public:
+	/*
+	USAGE: Constructor, builds the hull of the points with quickhull
+	ARGUMENTS: std::vector<vector3> const& a_lPointList -> points to wrap, in model space
+	OUTPUT: class object
+	*/
+	MyConvexHull(std::vector<vector3> const& a_lPointList);
+	/*
+	USAGE: Copy Constructor
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyConvexHull(MyConvexHull const& other);
+	/*
+	USAGE: Copy Assignment Operator
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyConvexHull& operator=(MyConvexHull const& other);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyConvexHull(void);
+	/*
+	USAGE: Changes object contents for other object's
+	ARGUMENTS:
+	- MyConvexHull& other -> object to swap content from
+	OUTPUT: ---
+	*/
+	void Swap(MyConvexHull& other);
+	/*
+	USAGE: Gets the hull of a model, it is built the first time a model with that name asks for it
+	and every entity using the model shares it
+	ARGUMENTS: Model* a_pModel -> model to wrap
+	OUTPUT: hull of the model, nullptr if the model has no name
+	*/
+	static MyConvexHull* GetHull(Model* a_pModel);
+	/*
+	USAGE: Deletes all the hulls built, no rigid body can be using them
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	static void ReleaseHulls(void);
+	/*
+	USAGE: Gets the vertex of the hull that is the furthest along a direction
+	ARGUMENTS: vector3 a_v3Direction -> direction in model space
+	OUTPUT: vertex in model space
+	*/
+	vector3 GetSupport(vector3 a_v3Direction);
+	/*
+	USAGE: Gets the vertices of the hull
+	ARGUMENTS: ---
+	OUTPUT: list of vertices in model space
+	*/
+	std::vector<vector3> GetVertexList(void);
+	/*
+	USAGE: Gets the number of triangles of the hull
+	ARGUMENTS: ---
+	OUTPUT: triangle count, 0 if the points were flat
+	*/
+	uint GetTriangleCount(void);
+
+private:
+	/*
+	USAGE: Deallocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Release(void);
+	/*
+	USAGE: Allocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Builds the hull with quickhull, starting from a tetrahedron of extreme points and adding
+	the furthest point outside a face until no point is left outside, if the points are flat the
+	hull keeps the extreme ones and has no triangles
+	ARGUMENTS: std::vector<vector3> const& a_lPointList -> points to wrap
+	OUTPUT: ---
+	*/
+	void Build(std::vector<vector3> const& a_lPointList);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYCONVEXHULL_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,567 @@
+#include "MyDynamicTree.h"
+using namespace Simplex;
+//  MyDynamicTree
+void MyDynamicTree::Init(void)
+{
+	m_lNode.clear();
+	m_nRoot = -1;
+	m_nFreeList = -1;
+	m_uLeafCount = 0;
+	m_mLeafMap.clear();
+	m_lStack.clear();
+	m_fMargin = 0.1f;
+	m_fPrediction = 2.0f;
+}
+void MyDynamicTree::Swap(MyDynamicTree& other)
+{
+	std::swap(m_lNode, other.m_lNode);
+	std::swap(m_nRoot, other.m_nRoot);
+	std::swap(m_nFreeList, other.m_nFreeList);
+	std::swap(m_uLeafCount, other.m_uLeafCount);
+	std::swap(m_mLeafMap, other.m_mLeafMap);
+	std::swap(m_lStack, other.m_lStack);
+	std::swap(m_fMargin, other.m_fMargin);
+	std::swap(m_fPrediction, other.m_fPrediction);
+}
+void MyDynamicTree::Release(void)
+{
+	m_lNode.clear();
+	m_nRoot = -1;
+	m_nFreeList = -1;
+	m_uLeafCount = 0;
+	m_mLeafMap.clear();
+	m_lStack.clear();
+}
+//The big 3
+MyDynamicTree::MyDynamicTree(void) { Init(); }
+MyDynamicTree::MyDynamicTree(MyDynamicTree const& other)
+{
+	m_lNode = other.m_lNode;
+	m_nRoot = other.m_nRoot;
+	m_nFreeList = other.m_nFreeList;
+	m_uLeafCount = other.m_uLeafCount;
+	m_mLeafMap = other.m_mLeafMap;
+	m_fMargin = other.m_fMargin;
+	m_fPrediction = other.m_fPrediction;
+}
+MyDynamicTree& MyDynamicTree::operator=(MyDynamicTree const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyDynamicTree temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyDynamicTree::~MyDynamicTree() { Release(); };
+//Accessors
+uint MyDynamicTree::GetLeafCount(void) { return m_uLeafCount; }
+int MyDynamicTree::GetHeight(void)
+{
+	if (m_nRoot == -1)
+		return 0;
+	return m_lNode[m_nRoot].m_nHeight;
+}
+void MyDynamicTree::SetMargin(float a_fMargin, float a_fPrediction)
+{
+	m_fMargin = std::max(a_fMargin, 0.0f);
+	m_fPrediction = std::max(a_fPrediction, 0.0f);
+}
+bool MyDynamicTree::Contains(MyRigidBody* a_pBody) { return m_mLeafMap.find(a_pBody) != m_mLeafMap.end(); }
+//Box helpers
+static float SurfaceArea(vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3Size = a_v3Max - a_v3Min;
+	return 2.0f * (v3Size.x * v3Size.y + v3Size.y * v3Size.z + v3Size.z * v3Size.x);
+}
+static bool IsBoxInside(vector3 a_v3MinIn, vector3 a_v3MaxIn, vector3 a_v3MinOut, vector3 a_v3MaxOut)
+{
+	return a_v3MinOut.x <= a_v3MinIn.x && a_v3MinOut.y <= a_v3MinIn.y && a_v3MinOut.z <= a_v3MinIn.z &&
+		a_v3MaxIn.x <= a_v3MaxOut.x && a_v3MaxIn.y <= a_v3MaxOut.y && a_v3MaxIn.z <= a_v3MaxOut.z;
+}
+static bool IsBoxOverlapping(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x)
+		return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y)
+		return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z)
+		return false;
+	return true;
+}
+//slab test, gives the distance at which the ray enters the box if that is before a_fMaxDistance
+static bool IsRayHittingBox(vector3 a_v3Origin, vector3 a_v3Direction, vector3 a_v3Min, vector3 a_v3Max,
+	float a_fMaxDistance, float& a_fDistance)
+{
+	float fEnter = 0.0f;
+	float fExit = a_fMaxDistance;
+	for (uint i = 0; i < 3; i++)
+	{
+		if (std::abs(a_v3Direction[i]) < 0.000001f)
+		{
+			//parallel to the slab, it needs to start inside of it
+			if (a_v3Origin[i] < a_v3Min[i] || a_v3Origin[i] > a_v3Max[i])
+				return false;
+			continue;
+		}
+		float fNear = (a_v3Min[i] - a_v3Origin[i]) / a_v3Direction[i];
+		float fFar = (a_v3Max[i] - a_v3Origin[i]) / a_v3Direction[i];
+		if (fNear > fFar)
+			std::swap(fNear, fFar);
+		fEnter = std::max(fEnter, fNear);
+		fExit = std::min(fExit, fFar);
+		if (fEnter > fExit)
+			return false;
+	}
+	a_fDistance = fEnter;
+	return true;
+}
+//--- Non Standard Singleton Methods
+int MyDynamicTree::AllocateNode(void)
+{
+	int nNode;
+	if (m_nFreeList == -1)
+	{
+		m_lNode.push_back(TreeNode());
+		nNode = static_cast<int>(m_lNode.size()) - 1;
+	}
+	else
+	{
+		nNode = m_nFreeList;
+		m_nFreeList = m_lNode[nNode].m_nParent;
+		m_lNode[nNode] = TreeNode();
+	}
+	m_lNode[nNode].m_nHeight = 0;
+	return nNode;
+}
+void MyDynamicTree::FreeNode(int a_nNode)
+{
+	m_lNode[a_nNode] = TreeNode();
+	m_lNode[a_nNode].m_nParent = m_nFreeList;
+	m_nFreeList = a_nNode;
+}
+void MyDynamicTree::ComputeFatBox(MyRigidBody* a_pBody, vector3 a_v3Velocity, vector3& a_v3Min, vector3& a_v3Max)
+{
+	a_v3Min = a_pBody->GetMinGlobal() - vector3(m_fMargin);
+	a_v3Max = a_pBody->GetMaxGlobal() + vector3(m_fMargin);
+
+	//grow it only towards where the body is going
+	vector3 v3Displacement = a_v3Velocity * m_fPrediction;
+	for (uint i = 0; i < 3; i++)
+	{
+		if (v3Displacement[i] < 0.0f)
+			a_v3Min[i] += v3Displacement[i];
+		else
+			a_v3Max[i] += v3Displacement[i];
+	}
+}
+void MyDynamicTree::Insert(MyRigidBody* a_pBody, uint a_uEntity, vector3 a_v3Velocity)
+{
+	if (Contains(a_pBody))
+	{
+		Move(a_pBody, a_uEntity, a_v3Velocity);
+		return;
+	}
+
+	int nLeaf = AllocateNode();
+	TreeNode& leaf = m_lNode[nLeaf];
+	leaf.m_pBody = a_pBody;
+	leaf.m_uEntity = a_uEntity;
+	ComputeFatBox(a_pBody, a_v3Velocity, leaf.m_v3Min, leaf.m_v3Max);
+	InsertLeaf(nLeaf);
+
+	m_mLeafMap[a_pBody] = nLeaf;
+	++m_uLeafCount;
+}
+void MyDynamicTree::Remove(MyRigidBody* a_pBody)
+{
+	std::map<MyRigidBody*, int>::iterator it = m_mLeafMap.find(a_pBody);
+	if (it == m_mLeafMap.end())
+		return;
+
+	RemoveLeaf(it->second);
+	FreeNode(it->second);
+	m_mLeafMap.erase(it);
+	--m_uLeafCount;
+}
+bool MyDynamicTree::Move(MyRigidBody* a_pBody, uint a_uEntity, vector3 a_v3Velocity)
+{
+	std::map<MyRigidBody*, int>::iterator it = m_mLeafMap.find(a_pBody);
+	if (it == m_mLeafMap.end())
+	{
+		Insert(a_pBody, a_uEntity, a_v3Velocity);
+		return true;
+	}
+
+	int nLeaf = it->second;
+	m_lNode[nLeaf].m_uEntity = a_uEntity;
+
+	vector3 v3Min;
+	vector3 v3Max;
+	ComputeFatBox(a_pBody, a_v3Velocity, v3Min, v3Max);
+
+	//the body is still inside its fat box, and the fat box is not much bigger than it needs to be
+	if (IsBoxInside(a_pBody->GetMinGlobal(), a_pBody->GetMaxGlobal(), m_lNode[nLeaf].m_v3Min, m_lNode[nLeaf].m_v3Max))
+	{
+		vector3 v3Huge = vector3(4.0f * m_fMargin);
+		if (IsBoxInside(m_lNode[nLeaf].m_v3Min, m_lNode[nLeaf].m_v3Max, v3Min - v3Huge, v3Max + v3Huge))
+			return false;
+	}
+
+	RemoveLeaf(nLeaf);
+	m_lNode[nLeaf].m_v3Min = v3Min;
+	m_lNode[nLeaf].m_v3Max = v3Max;
+	InsertLeaf(nLeaf);
+	return true;
+}
+void MyDynamicTree::InsertLeaf(int a_nLeaf)
+{
+	if (m_nRoot == -1)
+	{
+		m_nRoot = a_nLeaf;
+		m_lNode[a_nLeaf].m_nParent = -1;
+		return;
+	}
+
+	//walk down choosing the child that grows the least, stop when making a new parent here is cheaper
+	vector3 v3LeafMin = m_lNode[a_nLeaf].m_v3Min;
+	vector3 v3LeafMax = m_lNode[a_nLeaf].m_v3Max;
+	int nIndex = m_nRoot;
+	while (m_lNode[nIndex].m_nChild1 != -1)
+	{
+		TreeNode& node = m_lNode[nIndex];
+		float fArea = SurfaceArea(node.m_v3Min, node.m_v3Max);
+		float fCombinedArea = SurfaceArea(glm::min(node.m_v3Min, v3LeafMin), glm::max(node.m_v3Max, v3LeafMax));
+
+		//cost of making a new parent for this node and the leaf
+		float fCost = 2.0f * fCombinedArea;
+		//cost that every node below here pays because this one grows
+		float fInheritance = 2.0f * (fCombinedArea - fArea);
+
+		float fChildCost[2];
+		int nChild[2] = { node.m_nChild1, node.m_nChild2 };
+		for (uint i = 0; i < 2; i++)
+		{
+			TreeNode& child = m_lNode[nChild[i]];
+			float fChildArea = SurfaceArea(glm::min(child.m_v3Min, v3LeafMin), glm::max(child.m_v3Max, v3LeafMax));
+			if (child.m_nChild1 == -1)
+				fChildCost[i] = fChildArea + fInheritance;
+			else
+				fChildCost[i] = fChildArea - SurfaceArea(child.m_v3Min, child.m_v3Max) + fInheritance;
+		}
+
+		if (fCost < fChildCost[0] && fCost < fChildCost[1])
+			break;
+
+		nIndex = fChildCost[0] < fChildCost[1] ? nChild[0] : nChild[1];
+	}
+
+	//make a new parent for the sibling and the leaf
+	int nSibling = nIndex;
+	int nOldParent = m_lNode[nSibling].m_nParent;
+	int nNewParent = AllocateNode();
+	TreeNode& newParent = m_lNode[nNewParent];
+	newParent.m_nParent = nOldParent;
+	newParent.m_v3Min = glm::min(m_lNode[nSibling].m_v3Min, v3LeafMin);
+	newParent.m_v3Max = glm::max(m_lNode[nSibling].m_v3Max, v3LeafMax);
+	newParent.m_nHeight = m_lNode[nSibling].m_nHeight + 1;
+	newParent.m_nChild1 = nSibling;
+	newParent.m_nChild2 = a_nLeaf;
+
+	if (nOldParent != -1)
+	{
+		if (m_lNode[nOldParent].m_nChild1 == nSibling)
+			m_lNode[nOldParent].m_nChild1 = nNewParent;
+		else
+			m_lNode[nOldParent].m_nChild2 = nNewParent;
+	}
+	else
+	{
+		m_nRoot = nNewParent;
+	}
+	m_lNode[nSibling].m_nParent = nNewParent;
+	m_lNode[a_nLeaf].m_nParent = nNewParent;
+
+	FixUpwards(nNewParent);
+}
+void MyDynamicTree::RemoveLeaf(int a_nLeaf)
+{
+	if (a_nLeaf == m_nRoot)
+	{
+		m_nRoot = -1;
+		return;
+	}
+
+	int nParent = m_lNode[a_nLeaf].m_nParent;
+	int nGrandParent = m_lNode[nParent].m_nParent;
+	int nSibling = m_lNode[nParent].m_nChild1 == a_nLeaf ? m_lNode[nParent].m_nChild2 : m_lNode[nParent].m_nChild1;
+
+	//the sibling takes the place of the parent
+	if (nGrandParent != -1)
+	{
+		if (m_lNode[nGrandParent].m_nChild1 == nParent)
+			m_lNode[nGrandParent].m_nChild1 = nSibling;
+		else
+			m_lNode[nGrandParent].m_nChild2 = nSibling;
+		m_lNode[nSibling].m_nParent = nGrandParent;
+		FreeNode(nParent);
+		FixUpwards(nGrandParent);
+	}
+	else
+	{
+		m_nRoot = nSibling;
+		m_lNode[nSibling].m_nParent = -1;
+		FreeNode(nParent);
+	}
+	m_lNode[a_nLeaf].m_nParent = -1;
+}
+void MyDynamicTree::FixUpwards(int a_nNode)
+{
+	int nIndex = a_nNode;
+	while (nIndex != -1)
+	{
+		nIndex = Balance(nIndex);
+
+		TreeNode& node = m_lNode[nIndex];
+		TreeNode& child1 = m_lNode[node.m_nChild1];
+		TreeNode& child2 = m_lNode[node.m_nChild2];
+		node.m_nHeight = 1 + std::max(child1.m_nHeight, child2.m_nHeight);
+		node.m_v3Min = glm::min(child1.m_v3Min, child2.m_v3Min);
+		node.m_v3Max = glm::max(child1.m_v3Max, child2.m_v3Max);
+
+		nIndex = node.m_nParent;
+	}
+}
+int MyDynamicTree::Balance(int a_nNode)
+{
+	TreeNode& A = m_lNode[a_nNode];
+	if (A.m_nChild1 == -1 || A.m_nHeight < 2)
+		return a_nNode;
+
+	int nB = A.m_nChild1;
+	int nC = A.m_nChild2;
+	TreeNode& B = m_lNode[nB];
+	TreeNode& C = m_lNode[nC];
+	int nBalance = C.m_nHeight - B.m_nHeight;
+
+	//C is too tall, rotate it up
+	if (nBalance > 1)
+	{
+		int nF = C.m_nChild1;
+		int nG = C.m_nChild2;
+		TreeNode& F = m_lNode[nF];
+		TreeNode& G = m_lNode[nG];
+
+		//A becomes a child of C
+		C.m_nChild1 = a_nNode;
+		C.m_nParent = A.m_nParent;
+		A.m_nParent = nC;
+		if (C.m_nParent != -1)
+		{
+			if (m_lNode[C.m_nParent].m_nChild1 == a_nNode)
+				m_lNode[C.m_nParent].m_nChild1 = nC;
+			else
+				m_lNode[C.m_nParent].m_nChild2 = nC;
+		}
+		else
+		{
+			m_nRoot = nC;
+		}
+
+		//the taller child of C stays with C, the other one goes to A
+		if (F.m_nHeight > G.m_nHeight)
+		{
+			C.m_nChild2 = nF;
+			A.m_nChild2 = nG;
+			G.m_nParent = a_nNode;
+			A.m_v3Min = glm::min(B.m_v3Min, G.m_v3Min);
+			A.m_v3Max = glm::max(B.m_v3Max, G.m_v3Max);
+			C.m_v3Min = glm::min(A.m_v3Min, F.m_v3Min);
+			C.m_v3Max = glm::max(A.m_v3Max, F.m_v3Max);
+			A.m_nHeight = 1 + std::max(B.m_nHeight, G.m_nHeight);
+			C.m_nHeight = 1 + std::max(A.m_nHeight, F.m_nHeight);
+		}
+		else
+		{
+			C.m_nChild2 = nG;
+			A.m_nChild2 = nF;
+			F.m_nParent = a_nNode;
+			A.m_v3Min = glm::min(B.m_v3Min, F.m_v3Min);
+			A.m_v3Max = glm::max(B.m_v3Max, F.m_v3Max);
+			C.m_v3Min = glm::min(A.m_v3Min, G.m_v3Min);
+			C.m_v3Max = glm::max(A.m_v3Max, G.m_v3Max);
+			A.m_nHeight = 1 + std::max(B.m_nHeight, F.m_nHeight);
+			C.m_nHeight = 1 + std::max(A.m_nHeight, G.m_nHeight);
+		}
+		return nC;
+	}
+
+	//B is too tall, rotate it up
+	if (nBalance < -1)
+	{
+		int nD = B.m_nChild1;
+		int nE = B.m_nChild2;
+		TreeNode& D = m_lNode[nD];
+		TreeNode& E = m_lNode[nE];
+
+		//A becomes a child of B
+		B.m_nChild1 = a_nNode;
+		B.m_nParent = A.m_nParent;
+		A.m_nParent = nB;
+		if (B.m_nParent != -1)
+		{
+			if (m_lNode[B.m_nParent].m_nChild1 == a_nNode)
+				m_lNode[B.m_nParent].m_nChild1 = nB;
+			else
+				m_lNode[B.m_nParent].m_nChild2 = nB;
+		}
+		else
+		{
+			m_nRoot = nB;
+		}
+
+		//the taller child of B stays with B, the other one goes to A
+		if (D.m_nHeight > E.m_nHeight)
+		{
+			B.m_nChild2 = nD;
+			A.m_nChild1 = nE;
+			E.m_nParent = a_nNode;
+			A.m_v3Min = glm::min(C.m_v3Min, E.m_v3Min);
+			A.m_v3Max = glm::max(C.m_v3Max, E.m_v3Max);
+			B.m_v3Min = glm::min(A.m_v3Min, D.m_v3Min);
+			B.m_v3Max = glm::max(A.m_v3Max, D.m_v3Max);
+			A.m_nHeight = 1 + std::max(C.m_nHeight, E.m_nHeight);
+			B.m_nHeight = 1 + std::max(A.m_nHeight, D.m_nHeight);
+		}
+		else
+		{
+			B.m_nChild2 = nE;
+			A.m_nChild1 = nD;
+			D.m_nParent = a_nNode;
+			A.m_v3Min = glm::min(C.m_v3Min, D.m_v3Min);
+			A.m_v3Max = glm::max(C.m_v3Max, D.m_v3Max);
+			B.m_v3Min = glm::min(A.m_v3Min, E.m_v3Min);
+			B.m_v3Max = glm::max(A.m_v3Max, E.m_v3Max);
+			A.m_nHeight = 1 + std::max(C.m_nHeight, D.m_nHeight);
+			B.m_nHeight = 1 + std::max(A.m_nHeight, E.m_nHeight);
+		}
+		return nB;
+	}
+
+	return a_nNode;
+}
+void MyDynamicTree::QueryPairs(std::vector<EntityPair>& a_lPairList, std::vector<bool> const* a_pRestingList)
+{
+	if (m_nRoot == -1)
+		return;
+
+	//every leaf looks for the leafs it overlaps, the pair is kept by the one with the smaller node
+	uint uNodeCount = m_lNode.size();
+	for (uint uLeaf = 0; uLeaf < uNodeCount; uLeaf++)
+	{
+		TreeNode& leaf = m_lNode[uLeaf];
+		if (leaf.m_nHeight != 0)
+			continue;
+		if (a_pRestingList != nullptr && (*a_pRestingList)[leaf.m_uEntity])
+			continue;
+
+		m_lStack.clear();
+		m_lStack.push_back(m_nRoot);
+		while (!m_lStack.empty())
+		{
+			int nIndex = m_lStack.back();
+			m_lStack.pop_back();
+
+			TreeNode& node = m_lNode[nIndex];
+			if (!IsBoxOverlapping(leaf.m_v3Min, leaf.m_v3Max, node.m_v3Min, node.m_v3Max))
+				continue;
+
+			if (node.m_nChild1 == -1)
+			{
+				//a resting leaf does not look for its pairs, so this one keeps them
+				bool bResting = a_pRestingList != nullptr && (*a_pRestingList)[node.m_uEntity];
+				if (nIndex > static_cast<int>(uLeaf) || bResting)
+				{
+					a_lPairList.push_back(EntityPair(
+						std::min(leaf.m_uEntity, node.m_uEntity),
+						std::max(leaf.m_uEntity, node.m_uEntity)));
+				}
+			}
+			else
+			{
+				m_lStack.push_back(node.m_nChild1);
+				m_lStack.push_back(node.m_nChild2);
+			}
+		}
+	}
+}
+void MyDynamicTree::QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_lEntityList)
+{
+	if (m_nRoot == -1)
+		return;
+
+	m_lStack.clear();
+	m_lStack.push_back(m_nRoot);
+	while (!m_lStack.empty())
+	{
+		int nIndex = m_lStack.back();
+		m_lStack.pop_back();
+
+		TreeNode& node = m_lNode[nIndex];
+		if (!IsBoxOverlapping(a_v3Min, a_v3Max, node.m_v3Min, node.m_v3Max))
+			continue;
+
+		if (node.m_nChild1 == -1)
+		{
+			a_lEntityList.push_back(node.m_uEntity);
+		}
+		else
+		{
+			m_lStack.push_back(node.m_nChild1);
+			m_lStack.push_back(node.m_nChild2);
+		}
+	}
+}
+int MyDynamicTree::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance)
+{
+	if (m_nRoot == -1 || glm::length(a_v3Direction) == 0.0f)
+		return -1;
+	a_v3Direction = glm::normalize(a_v3Direction);
+
+	//nodes farther than the closest hit so far are skipped
+	int nHit = -1;
+	float fClosest = a_fDistance;
+	float fDistance = 0.0f;
+	m_lStack.clear();
+	m_lStack.push_back(m_nRoot);
+	while (!m_lStack.empty())
+	{
+		int nIndex = m_lStack.back();
+		m_lStack.pop_back();
+
+		TreeNode& node = m_lNode[nIndex];
+		if (!IsRayHittingBox(a_v3Origin, a_v3Direction, node.m_v3Min, node.m_v3Max, fClosest, fDistance))
+			continue;
+
+		if (node.m_nChild1 == -1)
+		{
+			//the fat box was hit, check the actual box of the body
+			if (IsRayHittingBox(a_v3Origin, a_v3Direction, node.m_pBody->GetMinGlobal(), node.m_pBody->GetMaxGlobal(), fClosest, fDistance))
+			{
+				fClosest = fDistance;
+				nHit = static_cast<int>(node.m_uEntity);
+			}
+		}
+		else
+		{
+			m_lStack.push_back(node.m_nChild1);
+			m_lStack.push_back(node.m_nChild2);
+		}
+	}
+
+	if (nHit != -1)
+		a_fDistance = fClosest;
+	return nHit;
+}
\ No newline at end of file
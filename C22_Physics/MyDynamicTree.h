@@ -0,0 +1,221 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYDYNAMICTREE_H_
+#define __MYDYNAMICTREE_H_
+
+#include "MyRigidBody.h"
+
+namespace Simplex
+{
+
+typedef std::pair<uint, uint> EntityPair; //pair of indices in the Entity Manager
+
+//System Class
+class MyDynamicTree
+{
+	struct TreeNode
+	{
+		vector3 m_v3Min = ZERO_V3; //minimum of the (fat) box of the node
+		vector3 m_v3Max = ZERO_V3; //maximum of the (fat) box of the node
+		int m_nParent = -1; //parent node, or next free node while in the free list
+		int m_nChild1 = -1; //first child, -1 on leafs
+		int m_nChild2 = -1; //second child, -1 on leafs
+		int m_nHeight = -1; //0 on leafs, -1 when the node is free
+		MyRigidBody* m_pBody = nullptr; //rigid body of the leaf
+		uint m_uEntity = 0; //index of the entity of the leaf in the Entity Manager
+	};
+
+	std::vector<TreeNode> m_lNode; //pool of nodes, free ones are linked through their parent
+	int m_nRoot = -1; //root node of the tree
+	int m_nFreeList = -1; //first free node in the pool
+	uint m_uLeafCount = 0; //number of rigid bodies in the tree
+
+	std::map<MyRigidBody*, int> m_mLeafMap; //leaf of each rigid body
+	std::vector<int> m_lStack; //stack used by the queries, kept to avoid allocations
+
+	float m_fMargin = 0.1f; //constant growth of the boxes on each side
+	float m_fPrediction = 2.0f; //frames of movement the boxes are grown along the velocity
+
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object
+	*/
+	MyDynamicTree(void);
+	/*
+	USAGE: Copy Constructor
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyDynamicTree(MyDynamicTree const& other);
+	/*
+	USAGE: Copy Assignment Operator
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyDynamicTree& operator=(MyDynamicTree const& other);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyDynamicTree(void);
+	/*
+	USAGE: Changes object contents for other object's
+	ARGUMENTS:
+	- MyDynamicTree& other -> object to swap content from
+	OUTPUT: ---
+	*/
+	void Swap(MyDynamicTree& other);
+	/*
+	USAGE: Adds a rigid body to the tree, its box is grown by the margin and by the velocity
+	ARGUMENTS:
+	- MyRigidBody* a_pBody -> rigid body to add
+	- uint a_uEntity -> index of its entity, reported by the queries
+	- vector3 a_v3Velocity -> velocity of the body per update (from its solver)
+	OUTPUT: ---
+	*/
+	void Insert(MyRigidBody* a_pBody, uint a_uEntity, vector3 a_v3Velocity = ZERO_V3);
+	/*
+	USAGE: Removes a rigid body from the tree
+	ARGUMENTS: MyRigidBody* a_pBody -> rigid body to remove
+	OUTPUT: ---
+	*/
+	void Remove(MyRigidBody* a_pBody);
+	/*
+	USAGE: Tells the tree the rigid body moved, it is only reinserted if it left its fat box
+	(or its fat box is too large for its velocity), adds the body if it was not in the tree
+	ARGUMENTS:
+	- MyRigidBody* a_pBody -> rigid body that moved
+	- uint a_uEntity -> index of its entity, reported by the queries
+	- vector3 a_v3Velocity -> velocity of the body per update (from its solver)
+	OUTPUT: was the body reinserted?
+	*/
+	bool Move(MyRigidBody* a_pBody, uint a_uEntity, vector3 a_v3Velocity = ZERO_V3);
+	/*
+	USAGE: Asks if the rigid body is in the tree
+	ARGUMENTS: MyRigidBody* a_pBody -> rigid body queried
+	OUTPUT: is it in the tree?
+	*/
+	bool Contains(MyRigidBody* a_pBody);
+	/*
+	USAGE: Finds all the pairs of rigid bodies whose fat boxes overlap, leaving out the pairs of resting ones
+	ARGUMENTS:
+	- std::vector<EntityPair>& a_lPairList -> list to add the pairs to (first is the smaller entity)
+	- std::vector<bool> const* a_pRestingList = nullptr -> which entities are resting, by index; the
+	resting ones do not look for pairs themselves, only the others find them
+	OUTPUT: ---
+	*/
+	void QueryPairs(std::vector<EntityPair>& a_lPairList, std::vector<bool> const* a_pRestingList = nullptr);
+	/*
+	USAGE: Finds the rigid bodies whose fat boxes overlap the given box
+	ARGUMENTS:
+	- vector3 a_v3Min -> minimum of the box
+	- vector3 a_v3Max -> maximum of the box
+	- std::vector<uint>& a_lEntityList -> list to add the entities to
+	OUTPUT: ---
+	*/
+	void QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_lEntityList);
+	/*
+	USAGE: Finds the closest rigid body (global ARBB) hit by the ray
+	ARGUMENTS:
+	- vector3 a_v3Origin -> start of the ray
+	- vector3 a_v3Direction -> direction of the ray
+	- float& a_fDistance -> in: max distance of the ray, out: distance to the hit
+	OUTPUT: index of the entity hit, -1 if none
+	*/
+	int RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance);
+	/*
+	USAGE: Gets the number of rigid bodies in the tree
+	ARGUMENTS: ---
+	OUTPUT: leaf count
+	*/
+	uint GetLeafCount(void);
+	/*
+	USAGE: Gets the height of the tree
+	ARGUMENTS: ---
+	OUTPUT: height, 0 if there is only one leaf
+	*/
+	int GetHeight(void);
+	/*
+	USAGE: Sets how much the boxes grow
+	ARGUMENTS:
+	- float a_fMargin -> constant growth on each side
+	- float a_fPrediction -> frames of movement the boxes are grown along the velocity
+	OUTPUT: ---
+	*/
+	void SetMargin(float a_fMargin, float a_fPrediction);
+
+private:
+	/*
+	USAGE: Deallocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Release(void);
+	/*
+	USAGE: Allocates member fields
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Takes a node from the pool
+	ARGUMENTS: ---
+	OUTPUT: index of the node
+	*/
+	int AllocateNode(void);
+	/*
+	USAGE: Gives a node back to the pool
+	ARGUMENTS: int a_nNode -> node to free
+	OUTPUT: ---
+	*/
+	void FreeNode(int a_nNode);
+	/*
+	USAGE: Computes the fat box of a rigid body
+	ARGUMENTS:
+	- MyRigidBody* a_pBody -> rigid body
+	- vector3 a_v3Velocity -> velocity of the body per update
+	- vector3& a_v3Min -> out: minimum of the fat box
+	- vector3& a_v3Max -> out: maximum of the fat box
+	OUTPUT: ---
+	*/
+	void ComputeFatBox(MyRigidBody* a_pBody, vector3 a_v3Velocity, vector3& a_v3Min, vector3& a_v3Max);
+	/*
+	USAGE: Places a leaf next to the node where it makes the smallest tree (by surface area)
+	ARGUMENTS: int a_nLeaf -> leaf to insert
+	OUTPUT: ---
+	*/
+	void InsertLeaf(int a_nLeaf);
+	/*
+	USAGE: Takes a leaf out of the tree, its sibling takes the place of their parent
+	ARGUMENTS: int a_nLeaf -> leaf to remove
+	OUTPUT: ---
+	*/
+	void RemoveLeaf(int a_nLeaf);
+	/*
+	USAGE: Rotates the node with one of its children if their heights differ by more than one
+	ARGUMENTS: int a_nNode -> node to balance
+	OUTPUT: node that took the place of a_nNode
+	*/
+	int Balance(int a_nNode);
+	/*
+	USAGE: Walks from the node to the root fixing the boxes and heights and balancing the tree
+	ARGUMENTS: int a_nNode -> first node to fix
+	OUTPUT: ---
+	*/
+	void FixUpwards(int a_nNode);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYDYNAMICTREE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
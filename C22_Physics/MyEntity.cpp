@@ -12,9 +12,7 @@ void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 	if (!m_bInMemory)
 		return;
 
-	m_m4ToWorld = a_m4ToWorld;
-	m_pModel->SetModelMatrix(m_m4ToWorld);
-	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
+	PlaceModel(a_m4ToWorld);
 
 	//experimental way of calculating a matrix components
 	glm::vec3 scale;
@@ -26,10 +24,17 @@ void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 
 	m_pSolver->SetPosition(translation);
 	m_pSolver->SetSize(scale);
+	m_pSolver->Wake();
 
 	//m_pSolver->SetPosition(vector3(m_m4ToWorld[3]));
 
 }
+void Simplex::MyEntity::PlaceModel(matrix4 a_m4ToWorld)
+{
+	m_m4ToWorld = a_m4ToWorld;
+	m_pModel->SetModelMatrix(m_m4ToWorld);
+	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
+}
 Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
 MyRigidBody* Simplex::MyEntity::GetRigidBody(void){	return m_pRigidBody; }
 bool Simplex::MyEntity::IsInitialized(void){ return m_bInMemory; }
@@ -68,9 +73,11 @@ void Simplex::MyEntity::Init(void)
 	m_pRigidBody = nullptr;
 	m_DimensionArray = nullptr;
 	m_m4ToWorld = IDENTITY_M4;
+	m_m4LastToWorld = IDENTITY_M4;
 	m_sUniqueID = "";
 	m_nDimensionCount = 0;
 	m_bUsePhysicsSolver = false;
+	m_bStatic = false;
 	m_pSolver = nullptr;
 }
 void Simplex::MyEntity::Swap(MyEntity& other)
@@ -79,12 +86,15 @@ void Simplex::MyEntity::Swap(MyEntity& other)
 	std::swap(m_pModel, other.m_pModel);
 	std::swap(m_pRigidBody, other.m_pRigidBody);
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
+	std::swap(m_m4LastToWorld, other.m_m4LastToWorld);
 	std::swap(m_pMeshMngr, other.m_pMeshMngr);
 	std::swap(m_bInMemory, other.m_bInMemory);
 	std::swap(m_sUniqueID, other.m_sUniqueID);
 	std::swap(m_bSetAxis, other.m_bSetAxis);
 	std::swap(m_nDimensionCount, other.m_nDimensionCount);
 	std::swap(m_DimensionArray, other.m_DimensionArray);
+	std::swap(m_bUsePhysicsSolver, other.m_bUsePhysicsSolver);
+	std::swap(m_bStatic, other.m_bStatic);
 	std::swap(m_pSolver, other.m_pSolver);
 }
 void Simplex::MyEntity::Release(void)
@@ -125,12 +135,16 @@ Simplex::MyEntity::MyEntity(MyEntity const& other)
 	m_pModel = other.m_pModel;
 	//generate a new rigid body we do not share the same rigid body as we do the model
 	m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); 
+	m_pRigidBody->SetConvexHull(other.m_pRigidBody->GetConvexHull());
 	m_m4ToWorld = other.m_m4ToWorld;
+	m_m4LastToWorld = other.m_m4LastToWorld;
 	m_pMeshMngr = other.m_pMeshMngr;
 	m_sUniqueID = other.m_sUniqueID;
 	m_bSetAxis = other.m_bSetAxis;
 	m_nDimensionCount = other.m_nDimensionCount;
 	m_DimensionArray = other.m_DimensionArray;
+	m_bUsePhysicsSolver = other.m_bUsePhysicsSolver;
+	m_bStatic = other.m_bStatic;
 	m_pSolver = new MySolver(*other.m_pSolver);
 }
 MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
@@ -306,20 +320,93 @@ void Simplex::MyEntity::ApplyForce(vector3 a_v3Force)
 }
 void Simplex::MyEntity::Update(void)
 {
-	if (m_bUsePhysicsSolver)
+	m_m4LastToWorld = m_m4ToWorld;
+	//the physics world already moved the solver and wrote its matrix, a still one does not need placing
+	if (m_bUsePhysicsSolver && m_bInMemory)
 	{
-		m_pSolver->Update();
-		SetModelMatrix(glm::translate(m_pSolver->GetPosition()) * glm::scale(m_pSolver->GetSize()));
+		matrix4 m4ToWorld = m_pSolver->GetModelMatrix();
+		if (m4ToWorld != m_m4ToWorld)
+			PlaceModel(m4ToWorld);
 	}
 }
-void Simplex::MyEntity::ResolveCollision(MyEntity* a_pOther)
+void Simplex::MyEntity::Interpolate(float a_fAlpha)
 {
-	if (m_bUsePhysicsSolver)
+	if (!m_bInMemory)
+		return;
+
+	//the solver only moves it, so only the position needs to be blended
+	matrix4 m4Render = m_m4ToWorld;
+	m4Render[3] = glm::mix(m_m4LastToWorld[3], m_m4ToWorld[3], a_fAlpha);
+	m_pModel->SetModelMatrix(m4Render);
+}
+bool Simplex::MyEntity::ResolveCollision(MyEntity* a_pOther)
+{
+	if (!m_bUsePhysicsSolver)
+		return false;
+
+	//the bounding boxes overlapping does not mean the oriented ones do
+	MyManifold manifold;
+	if (!m_pRigidBody->GetManifold(a_pOther->GetRigidBody(), manifold))
+		return false;
+
+	m_pSolver->AddContact(a_pOther->GetSolver(), manifold);
+	return true;
+}
+void Simplex::MyEntity::SetContinuous(bool a_bContinuous) { if (m_pSolver) m_pSolver->SetContinuous(a_bContinuous); }
+Simplex::vector3 Simplex::MyEntity::GetDisplacement(void)
+{
+	//only the bodies the update moves have gone anywhere
+	if (!m_bUsePhysicsSolver || m_bStatic || !m_pSolver->GetSimulated())
+		return ZERO_V3;
+	return m_pSolver->GetDisplacement();
+}
+bool Simplex::MyEntity::IsMovingFast(void)
+{
+	if (!m_bUsePhysicsSolver || !m_pSolver->GetContinuous())
+		return false;
+
+	//moving less than half of itself it cannot skip over anything as big as it is
+	vector3 v3HalfWidth = m_pRigidBody->GetHalfWidthGlobal();
+	float fSmallest = glm::min(v3HalfWidth.x, glm::min(v3HalfWidth.y, v3HalfWidth.z));
+	return glm::length(m_pSolver->GetDisplacement()) > fSmallest;
+}
+void Simplex::MyEntity::ResolveSweep(MyEntity* a_pOther, float a_fTime, vector3 a_v3Normal)
+{
+	//back to where they touched, the time is for how they moved relative to each other so both go back,
+	//the rest of the step is lost
+	m_pSolver->SetPosition(m_pSolver->GetPosition() - m_pSolver->GetDisplacement() * (1.0f - a_fTime));
+	PlaceModel(glm::translate(m_pSolver->GetPosition()) * glm::scale(m_pSolver->GetSize()));
+	if (a_pOther->IsUsingPhysicsSolver() && !a_pOther->IsStatic())
 	{
-		m_pSolver->ResolveCollision(a_pOther->GetSolver());
+		MySolver* pOther = a_pOther->GetSolver();
+		pOther->SetPosition(pOther->GetPosition() - pOther->GetDisplacement() * (1.0f - a_fTime));
+		a_pOther->PlaceModel(glm::translate(pOther->GetPosition()) * glm::scale(pOther->GetSize()));
 	}
+
+	//they are touching with no depth, only the velocities change
+	MyManifold manifold;
+	manifold.m_v3Normal = a_v3Normal;
+	m_pSolver->ResolveCollision(a_pOther->GetSolver(), manifold);
 }
+bool Simplex::MyEntity::IsAsleep(void) { return m_bUsePhysicsSolver && !m_pSolver->IsAwake(); }
+bool Simplex::MyEntity::IsUsingPhysicsSolver(void) { return m_bUsePhysicsSolver; }
 void Simplex::MyEntity::UsePhysicsSolver(bool a_bUse)
 {
 	m_bUsePhysicsSolver = a_bUse;
+	m_pSolver->SetSimulated(a_bUse && !m_bStatic);
+}
+void Simplex::MyEntity::SetStatic(bool a_bStatic)
+{
+	m_bStatic = a_bStatic;
+	m_pSolver->SetSimulated(m_bUsePhysicsSolver && !m_bStatic);
+
+	//it stays where it is from now on, not where the last update left it
+	m_pSolver->SetPosition(m_pSolver->GetPosition());
+}
+bool Simplex::MyEntity::IsStatic(void) { return m_bStatic; }
+void Simplex::MyEntity::UseConvexHull(bool a_bUse)
+{
+	if (!m_bInMemory)
+		return;
+	m_pRigidBody->SetConvexHull(a_bUse ? MyConvexHull::GetHull(m_pModel) : nullptr);
 }
\ No newline at end of file
@@ -24,11 +24,13 @@ class MyEntity
 	MyRigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this MyEntity
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this MyEntity
+	matrix4 m_m4LastToWorld = IDENTITY_M4; //Model matrix before the last update, to draw it in between
 	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
 
 	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
 
 	bool m_bUsePhysicsSolver = false; //Indicates if we will use a physics solver 
+	bool m_bStatic = false; //never moved by the solver, the manager keeps it apart from the moving ones
 
 	MySolver* m_pSolver = nullptr; //Physics MySolver
 
@@ -72,7 +74,7 @@ public:
 	*/
 	matrix4 GetModelMatrix(void);
 	/*
-	USAGE: Sets the model matrix associated with this entity
+	USAGE: Sets the model matrix associated with this entity, waking it if it was sleeping
 	ARGUMENTS: matrix4 a_m4ToWorld -> model matrix to set
 	OUTPUT: ---
 	*/
@@ -198,11 +200,12 @@ public:
 	bool HasThisRigidBody(MyRigidBody* a_pRigidBody);
 
 	/*
-	USAGE: Asks the entity to resolve the collision with the incoming one
+	USAGE: Asks the entity to resolve the collision with the incoming one, the contact manifold of their
+	oriented bounding boxes is handed to the physics world to be solved on its next update
 	ARGUMENTS: MyEntity* a_pOther -> Queried entity
-	OUTPUT: ---
+	OUTPUT: were the boxes in contact?
 	*/
-	void ResolveCollision(MyEntity* a_pOther);
+	bool ResolveCollision(MyEntity* a_pOther);
 
 	/*
 	USAGE: Gets the solver applied to this MyEntity
@@ -254,21 +257,94 @@ public:
 	OUTPUT: mass of the object
 	*/
 	float GetMass(void);
+	/*
+	USAGE: Sets if the solver checks for collisions along the way when it moves fast
+	ARGUMENTS: bool a_bContinuous -> check along the way?
+	OUTPUT: ---
+	*/
+	void SetContinuous(bool a_bContinuous);
+	/*
+	USAGE: Gets how much the entity moved in its last update
+	ARGUMENTS: ---
+	OUTPUT: displacement, zero if the physics solver does not move it
+	*/
+	vector3 GetDisplacement(void);
+	/*
+	USAGE: Tells if the entity moved further than its smallest half width in the last update with the
+	solver checking along the way, then it could have gone through other entities
+	ARGUMENTS: ---
+	OUTPUT: should its path be checked?
+	*/
+	bool IsMovingFast(void);
+	/*
+	USAGE: Takes the entity and the other one back to where they first touched during the last update
+	and resolves the collision there
+	ARGUMENTS:
+	-	MyEntity* a_pOther -> entity it touched
+	-	float a_fTime -> fraction of the update when they touched
+	-	vector3 a_v3Normal -> normal of the contact, from this entity to the other
+	OUTPUT: ---
+	*/
+	void ResolveSweep(MyEntity* a_pOther, float a_fTime, vector3 a_v3Normal);
 
 	/*
-	USAGE: Updates the MyEntity
+	USAGE: Updates the MyEntity, placing it where the physics world moved its solver
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Places the model to be drawn between where the entity was before the last update and where
+	it is now, the rigid body and the solver stay where the update left them
+	ARGUMENTS: float a_fAlpha -> 0 draws it where it was, 1 where it is
+	OUTPUT: ---
+	*/
+	void Interpolate(float a_fAlpha);
+	/*
+	USAGE: Asks if the entity uses the physics solver and it is sleeping
+	ARGUMENTS: ---
+	OUTPUT: is it asleep?
+	*/
+	bool IsAsleep(void);
+	/*
+	USAGE: Asks if the entity uses the physics solver
+	ARGUMENTS: ---
+	OUTPUT: using the physics solver?
+	*/
+	bool IsUsingPhysicsSolver(void);
+	/*
 	USAGE: Resolves using physics solver or not in the update
 	ARGUMENTS: bool a_bUse = true -> using physics solver?
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true);
+	/*
+	USAGE: Sets if the entity is static, it still collides but the solver never moves it
+	ARGUMENTS: bool a_bStatic = true -> is it static?
+	OUTPUT: ---
+	*/
+	void SetStatic(bool a_bStatic = true);
+	/*
+	USAGE: Asks if the entity is static
+	ARGUMENTS: ---
+	OUTPUT: is it static?
+	*/
+	bool IsStatic(void);
+	/*
+	USAGE: Collides using the convex hull of the model instead of only its box, the hull is built
+	the first time the model asks for it and shared with the entities of the same model
+	ARGUMENTS: bool a_bUse = true -> use the convex hull?
+	OUTPUT: ---
+	*/
+	void UseConvexHull(bool a_bUse = true);
 
 private:
+	/*
+	USAGE: Places the model and the rigid body, leaving the solver as it is
+	ARGUMENTS: matrix4 a_m4ToWorld -> model matrix to set
+	OUTPUT: ---
+	*/
+	void PlaceModel(matrix4 a_m4ToWorld);
 	/*
 	Usage: Deallocates member fields
 	Arguments: ---
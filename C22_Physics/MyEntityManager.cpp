@@ -6,9 +6,26 @@ void Simplex::MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
 	m_mEntityArray = nullptr;
+	m_pDynamicTree = nullptr;
+	m_pStaticTree = nullptr;
+	m_bStaticChanged = false;
+	m_lStaticList.clear();
+	m_lPairList.clear();
+	m_uPairCount = 0;
+	m_uContactCount = 0;
+	m_lRestingList.clear();
+
+	m_bFixedStep = false;
+	m_fStep = 1.0f / 60.0f;
+	m_uMaxSteps = 5;
+	m_fAccumulator = 0.0f;
+	m_uClock = -1;
+	m_uStepCount = 0;
 }
 void Simplex::MyEntityManager::Release(void)
 {
+	SafeDelete(m_pDynamicTree);
+	SafeDelete(m_pStaticTree);
 	for (uint uEntity = 0; uEntity < m_uEntityCount; ++uEntity)
 	{
 		MyEntity* pEntity = m_mEntityArray[uEntity];
@@ -123,8 +140,34 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUni
 	if (pTemp)
 	{
 		pTemp->SetModelMatrix(a_m4ToWorld);
+		if (pTemp->IsStatic())
+			m_bStaticChanged = true;
 	}
 }
+void Simplex::MyEntityManager::SetStatic(bool a_bStatic, String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//if the entity exists
+	if (pTemp)
+	{
+		pTemp->SetStatic(a_bStatic);
+		m_bStaticChanged = true;
+	}
+}
+void Simplex::MyEntityManager::SetStatic(bool a_bStatic, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	m_mEntityArray[a_uIndex]->SetStatic(a_bStatic);
+	m_bStaticChanged = true;
+}
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uIndex)
 {
 	//if the list is empty return
@@ -158,6 +201,8 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex
 		a_uIndex = m_uEntityCount - 1;
 
 	m_mEntityArray[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+	if (m_mEntityArray[a_uIndex]->IsStatic())
+		m_bStaticChanged = true;
 }
 //The big 3
 Simplex::MyEntityManager::MyEntityManager(){Init();}
@@ -167,27 +212,275 @@ Simplex::MyEntityManager::~MyEntityManager(){Release();};
 // other methods
 void Simplex::MyEntityManager::Update(void)
 {
-	//Clear all collisions
+	if (!m_bFixedStep)
+	{
+		Step();
+		m_uStepCount = 1;
+		return;
+	}
+
+	//catch up with the time that went by, in steps of the same size
+	m_fAccumulator += SystemSingleton::GetInstance()->GetDeltaTime(m_uClock);
+	m_uStepCount = 0;
+	while (m_fAccumulator >= m_fStep && m_uStepCount < m_uMaxSteps)
+	{
+		Step();
+		m_fAccumulator -= m_fStep;
+		++m_uStepCount;
+	}
+
+	//too far behind to catch up, the physics slow down instead of taking longer every frame
+	if (m_fAccumulator >= m_fStep)
+		m_fAccumulator = glm::mod(m_fAccumulator, m_fStep);
+
+	//draw them as far between the last two steps as the time left is into the next one
+	float fAlpha = m_fAccumulator / m_fStep;
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		m_mEntityArray[i]->Interpolate(fAlpha);
+	}
+}
+void Simplex::MyEntityManager::UseFixedStep(bool a_bUse, float a_fStep, uint a_uMaxSteps)
+{
+	if (a_bUse && !m_bFixedStep)
+	{
+		//the clock starts with the first fixed step update
+		SystemSingleton* pSystem = SystemSingleton::GetInstance();
+		if (m_uClock == static_cast<uint>(-1))
+			m_uClock = pSystem->GenClock();
+		pSystem->GetDeltaTime(m_uClock);
+		m_fAccumulator = 0.0f;
+	}
+	m_bFixedStep = a_bUse;
+	if (a_fStep > 0.0f)
+		m_fStep = a_fStep;
+	if (a_uMaxSteps > 0)
+		m_uMaxSteps = a_uMaxSteps;
+}
+Simplex::uint Simplex::MyEntityManager::GetStepCount(void) { return m_uStepCount; }
+void Simplex::MyEntityManager::Simulate(uint a_uSteps)
+{
+	for (uint i = 0; i < a_uSteps; i++)
+	{
+		Step();
+	}
+}
+void Simplex::MyEntityManager::SaveSnapshot(std::vector<char>& a_lBuffer)
+{
+	MyPhysicsWorld::GetInstance()->SaveSnapshot(a_lBuffer);
+}
+bool Simplex::MyEntityManager::LoadSnapshot(std::vector<char> const& a_lBuffer)
+{
+	if (!MyPhysicsWorld::GetInstance()->LoadSnapshot(a_lBuffer))
+		return false;
+
+	//the rigid bodies follow the solvers, and the tree all of them as the sleeping ones are not moved in a step
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		m_mEntityArray[i]->Update();
+		if (m_pDynamicTree != nullptr && !m_mEntityArray[i]->IsStatic())
+			m_pDynamicTree->Move(m_mEntityArray[i]->GetRigidBody(), i, m_mEntityArray[i]->GetVelocity());
+	}
+	//the static ones may have been placed somewhere else since the snapshot, their tree is built again
+	m_bStaticChanged = true;
+	return true;
+}
+void Simplex::MyEntityManager::Step(void)
+{
+	//Clear all collisions, and see who is sleeping
+	m_lRestingList.resize(m_uEntityCount);
 	for (uint i = 0; i < m_uEntityCount; i++)
 	{
 		m_mEntityArray[i]->ClearCollisionList();
+		m_lRestingList[i] = m_mEntityArray[i]->IsAsleep();
 	}
 	
-	//check collisions
-	for (uint i = 0; i < m_uEntityCount; i++)
+	//without a tree every pair needs to be checked
+	if (m_pDynamicTree == nullptr)
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		m_uPairCount = 0;
+		m_uContactCount = 0;
+		//check collisions
+		for (uint i = 0; i < m_uEntityCount; i++)
 		{
-			//if objects are colliding resolve the collision
-			if (m_mEntityArray[i]->IsColliding(m_mEntityArray[j]))
+			for (uint j = i + 1; j < m_uEntityCount; j++)
 			{
-				m_mEntityArray[i]->ResolveCollision(m_mEntityArray[j]);
+				//two static entities never move into each other
+				MyEntity* pEntity = m_mEntityArray[i];
+				MyEntity* pOther = m_mEntityArray[j];
+				if (IsRestingPair(i, j) || (pEntity->IsStatic() && pOther->IsStatic()))
+					continue;
+				++m_uPairCount;
+				//the moving one resolves it
+				if (pEntity->IsStatic())
+					std::swap(pEntity, pOther);
+				//if objects are colliding resolve the collision
+				if (pEntity->IsColliding(pOther))
+				{
+					if (pEntity->ResolveCollision(pOther))
+						++m_uContactCount;
+				}
 			}
 		}
-		//Update each entity
+		UpdateEntities();
+		SweepFastEntities();
+		return;
+	}
+
+	//the static entities are only put in their tree when they change
+	if (m_bStaticChanged)
+		BuildStaticTree();
+
+	//tell the tree where the bodies are, only the ones that left their fat box get moved, sleeping ones do not move
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		if (!m_lRestingList[i] && !m_mEntityArray[i]->IsStatic())
+			m_pDynamicTree->Move(m_mEntityArray[i]->GetRigidBody(), i, m_mEntityArray[i]->GetVelocity());
+	}
+
+	//only the entities whose fat boxes overlap can be colliding, and the sleeping ones do not look for pairs
+	m_lPairList.clear();
+	m_pDynamicTree->QueryPairs(m_lPairList, &m_lRestingList);
+
+	//the static ones never look for pairs, the moving ones find them in the static tree (and go first to resolve them)
+	if (m_pStaticTree->GetLeafCount() > 0)
+	{
+		for (uint i = 0; i < m_uEntityCount; i++)
+		{
+			if (m_lRestingList[i] || m_mEntityArray[i]->IsStatic())
+				continue;
+			MyRigidBody* pBody = m_mEntityArray[i]->GetRigidBody();
+			m_lStaticList.clear();
+			m_pStaticTree->QueryAABB(pBody->GetMinGlobal(), pBody->GetMaxGlobal(), m_lStaticList);
+			for (uint c = 0; c < m_lStaticList.size(); c++)
+				m_lPairList.push_back(EntityPair(i, m_lStaticList[c]));
+		}
+	}
+	m_uPairCount = m_lPairList.size();
+	m_uContactCount = 0;
+	for (uint i = 0; i < m_uPairCount; i++)
+	{
+		if (IsRestingPair(m_lPairList[i].first, m_lPairList[i].second))
+			continue;
+		MyEntity* pEntity = m_mEntityArray[m_lPairList[i].first];
+		MyEntity* pOther = m_mEntityArray[m_lPairList[i].second];
+		//if objects are colliding resolve the collision
+		if (pEntity->IsColliding(pOther))
+		{
+			if (pEntity->ResolveCollision(pOther))
+				++m_uContactCount;
+		}
+	}
+
+	UpdateEntities();
+	SweepFastEntities();
+}
+bool Simplex::MyEntityManager::IsRestingPair(uint a_uIndex, uint a_uOther)
+{
+	if (!m_lRestingList[a_uIndex] && !m_lRestingList[a_uOther])
+		return false;
+
+	//one is sleeping, it only needs checking if the other one is moved by the solver, static ones never are
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+	MyEntity* pOther = m_mEntityArray[a_uOther];
+	bool bMoving = pEntity->IsUsingPhysicsSolver() && !pEntity->IsStatic() && !m_lRestingList[a_uIndex];
+	bool bOtherMoving = pOther->IsUsingPhysicsSolver() && !pOther->IsStatic() && !m_lRestingList[a_uOther];
+	return !bMoving && !bOtherMoving;
+}
+void Simplex::MyEntityManager::BuildStaticTree(void)
+{
+	//the same leaves inserted again would not make a better tree, so it starts empty
+	SafeDelete(m_pStaticTree);
+	m_pStaticTree = new MyDynamicTree();
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		if (!m_mEntityArray[i]->IsStatic())
+			continue;
+		m_pDynamicTree->Remove(m_mEntityArray[i]->GetRigidBody());
+		m_pStaticTree->Insert(m_mEntityArray[i]->GetRigidBody(), i);
+	}
+	m_bStaticChanged = false;
+}
+void Simplex::MyEntityManager::UpdateEntities(void)
+{
+	//all the solvers move at once, then each entity is placed where its solver went
+	MyPhysicsWorld::GetInstance()->Update();
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
 		m_mEntityArray[i]->Update();
 	}
 }
+void Simplex::MyEntityManager::SweepFastEntities(void)
+{
+	std::vector<uint> lCandidate;
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		MyEntity* pEntity = m_mEntityArray[i];
+		if (!pEntity->IsMovingFast())
+			continue;
+
+		//the entities around the whole path, from the tree if there is one
+		MyRigidBody* pBody = pEntity->GetRigidBody();
+		vector3 v3Displacement = pEntity->GetDisplacement();
+		lCandidate.clear();
+		if (m_pDynamicTree != nullptr)
+		{
+			vector3 v3Min = pBody->GetMinGlobal();
+			vector3 v3Max = pBody->GetMaxGlobal();
+			m_pDynamicTree->QueryAABB(glm::min(v3Min, v3Min - v3Displacement), glm::max(v3Max, v3Max - v3Displacement), lCandidate);
+			m_pStaticTree->QueryAABB(glm::min(v3Min, v3Min - v3Displacement), glm::max(v3Max, v3Max - v3Displacement), lCandidate);
+		}
+		else
+		{
+			for (uint j = 0; j < m_uEntityCount; j++)
+				lCandidate.push_back(j);
+		}
+
+		//the first one it touches along the way
+		int nFirst = -1;
+		float fFirst = 1.0f;
+		vector3 v3FirstNormal = ZERO_V3;
+		for (uint c = 0; c < lCandidate.size(); c++)
+		{
+			uint j = lCandidate[c];
+			if (j == i)
+				continue;
+			MyEntity* pOther = m_mEntityArray[j];
+			float fTime = 0.0f;
+			vector3 v3Normal = ZERO_V3;
+			if (pBody->SweepARBB(pOther->GetRigidBody(), v3Displacement - pOther->GetDisplacement(), fTime, v3Normal) && fTime < fFirst)
+			{
+				nFirst = j;
+				fFirst = fTime;
+				v3FirstNormal = v3Normal;
+			}
+		}
+
+		if (nFirst != -1)
+		{
+			pEntity->ResolveSweep(m_mEntityArray[nFirst], fFirst, v3FirstNormal);
+			++m_uContactCount;
+		}
+	}
+}
+void Simplex::MyEntityManager::UseDynamicTree(bool a_bUse)
+{
+	if (a_bUse && m_pDynamicTree == nullptr)
+	{
+		m_pDynamicTree = new MyDynamicTree();
+		m_pStaticTree = new MyDynamicTree();
+		m_bStaticChanged = true;
+	}
+	else if (!a_bUse)
+	{
+		SafeDelete(m_pDynamicTree);
+		SafeDelete(m_pStaticTree);
+	}
+}
+Simplex::MyDynamicTree* Simplex::MyEntityManager::GetDynamicTree(void) { return m_pDynamicTree; }
+Simplex::uint Simplex::MyEntityManager::GetPairCount(void) { return m_uPairCount; }
+Simplex::uint Simplex::MyEntityManager::GetSleepingCount(void) { return MyPhysicsWorld::GetInstance()->GetSleepingCount(); }
+Simplex::uint Simplex::MyEntityManager::GetContactCount(void) { return m_uContactCount; }
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
 	//Create a temporal entity to store the object
@@ -226,13 +519,29 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//the tree cannot keep a body that is no longer managed, the static tree is built again without it
+	if (m_pDynamicTree != nullptr)
+	{
+		m_pDynamicTree->Remove(m_mEntityArray[a_uIndex]->GetRigidBody());
+		m_pStaticTree->Remove(m_mEntityArray[a_uIndex]->GetRigidBody());
+	}
+	if (m_mEntityArray[a_uIndex]->IsStatic())
+		m_bStaticChanged = true;
+
 	// if the entity is not the very last we swap it for the last one
 	if (a_uIndex != m_uEntityCount - 1)
 	{
 		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[m_uEntityCount - 1]);
+
+		//its leaf has to report the new index, a sleeping entity would not tell the tree on the update
+		if (m_mEntityArray[a_uIndex]->IsStatic())
+			m_bStaticChanged = true;
+		else if (m_pDynamicTree != nullptr)
+			m_pDynamicTree->Move(m_mEntityArray[a_uIndex]->GetRigidBody(), a_uIndex, m_mEntityArray[a_uIndex]->GetVelocity());
 	}
 	
-	//and then pop the last one
+	//and then pop the last one, its solver gives its body back to the physics world
+	SafeDelete(m_mEntityArray[m_uEntityCount - 1]);
 	//create a new temp array with one less entry
 	PEntity* tempArray = new PEntity[m_uEntityCount - 1];
 	//start from 0 to the current count
@@ -495,6 +804,31 @@ void Simplex::MyEntityManager::SetMass(float a_fMass, uint a_uIndex)
 
 	return;
 }
+void Simplex::MyEntityManager::SetContinuous(bool a_bContinuous, String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//if the entity does not exists return
+	if (pTemp)
+	{
+		pTemp->SetContinuous(a_bContinuous);
+	}
+	return;
+}
+void Simplex::MyEntityManager::SetContinuous(bool a_bContinuous, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	m_mEntityArray[a_uIndex]->SetContinuous(a_bContinuous);
+
+	return;
+}
 void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, String a_sUniqueID)
 {
 	//Get the entity
@@ -516,4 +850,30 @@ void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, uint a_uIndex)
 		a_uIndex = m_uEntityCount - 1;
 
 	return m_mEntityArray[a_uIndex]->UsePhysicsSolver(a_bUse);
+}
+void Simplex::MyEntityManager::SetSolverMode(eSolverMode a_nMode)
+{
+	MyPhysicsWorld::GetInstance()->SetSolverMode(a_nMode);
+}
+void Simplex::MyEntityManager::UseConvexHull(bool a_bUse, String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+
+	//if the entity does not exists return
+	if (pTemp)
+		pTemp->UseConvexHull(a_bUse);
+	return;
+}
+void Simplex::MyEntityManager::UseConvexHull(bool a_bUse, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	return m_mEntityArray[a_uIndex]->UseConvexHull(a_bUse);
 }
\ No newline at end of file
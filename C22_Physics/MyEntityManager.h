@@ -6,6 +6,7 @@ Date: 2017/07
 #define __MYENTITYMANAGER_H_
 
 #include "MyEntity.h"
+#include "MyDynamicTree.h"
 
 namespace Simplex
 {
@@ -17,6 +18,22 @@ class MyEntityManager
 	uint m_uEntityCount = 0; //number of elements in the list
 	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
 	static MyEntityManager* m_pInstance; // Singleton pointer
+
+	MyDynamicTree* m_pDynamicTree = nullptr; //tree that tells which pairs to check, nullptr checks all pairs
+	MyDynamicTree* m_pStaticTree = nullptr; //tree of the static entities, only built again when they change
+	bool m_bStaticChanged = false; //an entity became static or not, or a static one was moved or removed
+	std::vector<uint> m_lStaticList; //static entities near the one looking for pairs, kept to avoid allocations
+	std::vector<EntityPair> m_lPairList; //pairs given by the tree in the last update
+	uint m_uPairCount = 0; //number of pairs checked in the last update
+	uint m_uContactCount = 0; //number of pairs in contact in the last update
+	std::vector<bool> m_lRestingList; //entities that were sleeping at the start of the update, by index
+
+	bool m_bFixedStep = false; //steps the physics by a fixed time instead of once per update
+	float m_fStep = 1.0f / 60.0f; //time of each physics step
+	uint m_uMaxSteps = 5; //most steps taken in one update, the time they could not take is dropped
+	float m_fAccumulator = 0.0f; //time that went by and has not been stepped yet
+	uint m_uClock = -1; //clock of the system measuring the time between updates
+	uint m_uStepCount = 0; //number of steps taken in the last update
 public:
 	/*
 	Usage: Gets the singleton pointer
@@ -69,12 +86,48 @@ public:
 	*/
 	MyEntity* GetEntity(uint a_uIndex = -1);
 	/*
-	USAGE: Will update the MyEntity manager
+	USAGE: Will update the MyEntity manager, with a fixed step it takes as many steps as the time that
+	went by allows and draws the entities between the last two
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Steps the physics by a fixed time, so they go at the same speed whatever the frame rate is
+	ARGUMENTS:
+	-	bool a_bUse = true -> use a fixed step? if not the physics step once per update
+	-	float a_fStep = 1.0f / 60.0f -> seconds of each step, gravity and friction are tuned for 60 per second
+	-	uint a_uMaxSteps = 5 -> most steps in one update, so a slow frame does not make the next one slower
+	OUTPUT: ---
+	*/
+	void UseFixedStep(bool a_bUse = true, float a_fStep = 1.0f / 60.0f, uint a_uMaxSteps = 5);
+	/*
+	USAGE: Gets the number of physics steps taken in the last update
+	ARGUMENTS: ---
+	OUTPUT: step count
+	*/
+	uint GetStepCount(void);
+	/*
+	USAGE: Takes a number of physics steps right away, whatever time went by; to resimulate the steps that
+	followed a snapshot
+	ARGUMENTS: uint a_uSteps = 1 -> number of steps
+	OUTPUT: ---
+	*/
+	void Simulate(uint a_uSteps = 1);
+	/*
+	USAGE: Saves the state of the physics world into a buffer, see MyPhysicsWorld::SaveSnapshot
+	ARGUMENTS: std::vector<char>& a_lBuffer -> buffer to write, its contents are replaced
+	OUTPUT: ---
+	*/
+	void SaveSnapshot(std::vector<char>& a_lBuffer);
+	/*
+	USAGE: Loads a state saved by SaveSnapshot and places the entities where their solvers are, the same
+	entities need to be in the manager
+	ARGUMENTS: std::vector<char> const& a_lBuffer -> buffer to read
+	OUTPUT: was it loaded?
+	*/
+	bool LoadSnapshot(std::vector<char> const& a_lBuffer);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: Model
@@ -127,6 +180,24 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID);
 	/*
+	USAGE: Sets if the specified entity is static, it collides with the moving ones but the solver never
+	moves it and it is never checked against the other static ones
+	ARGUMENTS:
+	-	bool a_bStatic -> is it static?
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: ---
+	*/
+	void SetStatic(bool a_bStatic, String a_sUniqueID);
+	/*
+	USAGE: Sets if the specified entity is static, it collides with the moving ones but the solver never
+	moves it and it is never checked against the other static ones
+	ARGUMENTS:
+	-	bool a_bStatic = true -> is it static?
+	-	uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: ---
+	*/
+	void SetStatic(bool a_bStatic = true, uint a_uIndex = -1);
+	/*
 	USAGE: Sets the axis visibility associated to the entity specified in the ID
 	ARGUMENTS: 
 	-	bool a_bVisibility -> visibility of the axis
@@ -296,6 +367,22 @@ public:
 	*/
 	void SetMass(float a_v3Position, uint a_uIndex = -1);
 	/*
+	USAGE: Sets if the specified entity checks for collisions along the way when it moves fast
+	ARGUMENTS:
+	-	bool a_bContinuous -> check along the way?
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: ---
+	*/
+	void SetContinuous(bool a_bContinuous, String a_sUniqueID);
+	/*
+	USAGE: Sets if the specified entity checks for collisions along the way when it moves fast
+	ARGUMENTS:
+	-	bool a_bContinuous = true -> check along the way?
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: ---
+	*/
+	void SetContinuous(bool a_bContinuous = true, uint a_uIndex = -1);
+	/*
 	USAGE: Sets the using physics solver flag for the specified object
 	ARGUMENTS:
 	-	bool a_bUse -> Using physics?
@@ -311,6 +398,60 @@ public:
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true, uint a_uIndex = -1);
+	/*
+	USAGE: Sets how the physics world solves the contacts of the whole scene
+	ARGUMENTS: eSolverMode a_nMode -> SOLVER_IMPULSE for impulses on the velocities, SOLVER_POSITION to
+	project the positions over substeps
+	OUTPUT: ---
+	*/
+	void SetSolverMode(eSolverMode a_nMode);
+	/*
+	USAGE: Sets the using convex hull flag for the specified object
+	ARGUMENTS:
+	-	bool a_bUse -> Using the convex hull for collisions?
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: ---
+	*/
+	void UseConvexHull(bool a_bUse, String a_sUniqueID);
+	/*
+	USAGE: Sets the using convex hull flag for the specified object
+	ARGUMENTS:
+	-	bool a_bUse -> Using the convex hull for collisions?
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: ---
+	*/
+	void UseConvexHull(bool a_bUse = true, uint a_uIndex = -1);
+	/*
+	USAGE: Turns on or off the dynamic tree, while on only the entities whose fat boxes overlap
+	are checked for collision; the static entities go in a tree of their own
+	ARGUMENTS: bool a_bUse = true -> use the tree?
+	OUTPUT: ---
+	*/
+	void UseDynamicTree(bool a_bUse = true);
+	/*
+	USAGE: Gets the dynamic tree to ask it for boxes or rays
+	ARGUMENTS: ---
+	OUTPUT: dynamic tree, nullptr if it is not in use
+	*/
+	MyDynamicTree* GetDynamicTree(void);
+	/*
+	USAGE: Gets the number of entities sleeping
+	ARGUMENTS: ---
+	OUTPUT: sleeping count
+	*/
+	uint GetSleepingCount(void);
+	/*
+	USAGE: Gets the number of pairs checked for collision in the last update
+	ARGUMENTS: ---
+	OUTPUT: pair count
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Gets the number of pairs whose oriented bounding boxes were in contact in the last update
+	ARGUMENTS: ---
+	OUTPUT: contact count
+	*/
+	uint GetContactCount(void);
 private:
 	/*
 	Usage: constructor
@@ -348,6 +489,40 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	USAGE: Checks the path of the entities that moved fast in the update against the ones around it,
+	and takes each back to the first one it touched so it cannot go through it
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SweepFastEntities(void);
+	/*
+	USAGE: Asks if the pair does not need to be checked because it is resting, a sleeping entity only
+	meets the entities the solver is moving
+	ARGUMENTS:
+	-	uint a_uIndex -> index of one entity
+	-	uint a_uOther -> index of the other entity
+	OUTPUT: can it be skipped?
+	*/
+	bool IsRestingPair(uint a_uIndex, uint a_uOther);
+	/*
+	USAGE: Updates the physics world and then each entity
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateEntities(void);
+	/*
+	USAGE: Builds the tree of the static entities again and takes them out of the dynamic tree
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void BuildStaticTree(void);
+	/*
+	USAGE: Advances the physics one step, finds the pairs in contact, resolves them and updates the entities
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Step(void);
 };//class
 
 } //namespace Simplex
@@ -0,0 +1,1168 @@
+#include "MyPhysicsWorld.h"
+#include "MyThreadPool.h"
+#include <cstring>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+using namespace Simplex;
+//  MyPhysicsWorld
+MyPhysicsWorld* MyPhysicsWorld::m_pInstance = nullptr;
+void MyPhysicsWorld::Init(void)
+{
+	//the arrays themselves never move, only what they hold does
+	m_lFloatArray = { &m_lPositionX, &m_lPositionY, &m_lPositionZ,
+		&m_lVelocityX, &m_lVelocityY, &m_lVelocityZ, &m_lAccelerationX, &m_lAccelerationY, &m_lAccelerationZ,
+		&m_lLastPositionX, &m_lLastPositionY, &m_lLastPositionZ, &m_lSizeX, &m_lSizeY, &m_lSizeZ,
+		&m_lMass, &m_lSimulated, &m_lAwake, &m_lRestPositionX, &m_lRestPositionY, &m_lRestPositionZ,
+		&m_lPushX, &m_lPushY, &m_lPushZ, &m_lSubstepX, &m_lSubstepY, &m_lSubstepZ };
+	m_lFreeList.clear();
+	m_uBodyCount = 0;
+	m_mSleepingIslandMap.clear();
+	m_uNextIsland = 0;
+	m_uSleepingCount = 0;
+	m_uIslandCount = 0;
+	m_lContactList.clear();
+	m_mImpulseMap.clear();
+}
+void MyPhysicsWorld::Release(void)
+{
+	for (std::vector<float>* pList : GetFloatArrays())
+		pList->clear();
+	m_lContinuous.clear();
+	m_lModelMatrix.clear();
+	m_lStillSteps.clear();
+	m_lSleepingIsland.clear();
+	m_lIsland.clear();
+	m_lIslandSteps.clear();
+	Init();
+}
+MyPhysicsWorld* MyPhysicsWorld::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyPhysicsWorld();
+	}
+	return m_pInstance;
+}
+void MyPhysicsWorld::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+MyPhysicsWorld::MyPhysicsWorld(){ Init(); }
+MyPhysicsWorld::MyPhysicsWorld(MyPhysicsWorld const& a_pOther){ }
+MyPhysicsWorld& MyPhysicsWorld::operator=(MyPhysicsWorld const& a_pOther) { return *this; }
+MyPhysicsWorld::~MyPhysicsWorld(){ Release(); };
+//Bodies
+uint MyPhysicsWorld::AddBody(void)
+{
+	uint uBody = 0;
+	if (!m_lFreeList.empty())
+	{
+		uBody = m_lFreeList.back();
+		m_lFreeList.pop_back();
+	}
+	else
+	{
+		uBody = static_cast<uint>(m_lMass.size());
+		for (std::vector<float>* pList : GetFloatArrays())
+			pList->push_back(0.0f);
+		m_lContinuous.push_back(false);
+		m_lModelMatrix.push_back(IDENTITY_M4);
+		m_lStillSteps.push_back(0);
+		m_lSleepingIsland.push_back(-1);
+	}
+	ResetBody(uBody);
+	++m_uBodyCount;
+	return uBody;
+}
+void MyPhysicsWorld::RemoveBody(uint a_uBody)
+{
+	if (a_uBody >= m_lMass.size())
+		return;
+
+	//the bodies that were resting on it have to notice it is gone
+	WakeBody(a_uBody);
+
+	//a body added later in the same index cannot start from the impulses of this one
+	for (std::map<std::pair<uint, uint>, vector3>::iterator it = m_mImpulseMap.begin(); it != m_mImpulseMap.end();)
+	{
+		if (it->first.first == a_uBody || it->first.second == a_uBody)
+			it = m_mImpulseMap.erase(it);
+		else
+			++it;
+	}
+
+	//a removed body stays in the arrays, the update skips it until the index is used again
+	ResetBody(a_uBody);
+	m_lFreeList.push_back(a_uBody);
+	--m_uBodyCount;
+}
+void MyPhysicsWorld::ResetBody(uint a_uBody)
+{
+	SetPosition(a_uBody, ZERO_V3);
+	m_lLastPositionX[a_uBody] = m_lLastPositionY[a_uBody] = m_lLastPositionZ[a_uBody] = 0.0f;
+	m_lRestPositionX[a_uBody] = m_lRestPositionY[a_uBody] = m_lRestPositionZ[a_uBody] = 0.0f;
+	m_lPushX[a_uBody] = m_lPushY[a_uBody] = m_lPushZ[a_uBody] = 0.0f;
+	m_lSubstepX[a_uBody] = m_lSubstepY[a_uBody] = m_lSubstepZ[a_uBody] = 0.0f;
+	SetVelocity(a_uBody, ZERO_V3);
+	SetAcceleration(a_uBody, ZERO_V3);
+	SetSize(a_uBody, vector3(1.0f));
+	m_lMass[a_uBody] = 1.0f;
+	m_lSimulated[a_uBody] = 0.0f;
+	m_lAwake[a_uBody] = 1.0f;
+	m_lContinuous[a_uBody] = false;
+	m_lModelMatrix[a_uBody] = IDENTITY_M4;
+	m_lStillSteps[a_uBody] = 0;
+	m_lSleepingIsland[a_uBody] = -1;
+}
+void MyPhysicsWorld::CopyBody(uint a_uSource, uint a_uTarget)
+{
+	for (std::vector<float>* pList : GetFloatArrays())
+		(*pList)[a_uTarget] = (*pList)[a_uSource];
+	m_lContinuous[a_uTarget] = m_lContinuous[a_uSource];
+	m_lModelMatrix[a_uTarget] = m_lModelMatrix[a_uSource];
+
+	//the copy is not part of the island of the original, it starts awake
+	m_lAwake[a_uTarget] = 1.0f;
+	m_lStillSteps[a_uTarget] = 0;
+	m_lSleepingIsland[a_uTarget] = -1;
+}
+void MyPhysicsWorld::Reserve(uint a_uCount)
+{
+	for (std::vector<float>* pList : GetFloatArrays())
+		pList->reserve(a_uCount);
+	m_lContinuous.reserve(a_uCount);
+	m_lModelMatrix.reserve(a_uCount);
+	m_lStillSteps.reserve(a_uCount);
+	m_lSleepingIsland.reserve(a_uCount);
+}
+uint MyPhysicsWorld::GetBodyCount(void) { return m_uBodyCount; }
+std::vector<std::vector<float>*> const& MyPhysicsWorld::GetFloatArrays(void) { return m_lFloatArray; }
+//Accessors
+void MyPhysicsWorld::SetPosition(uint a_uBody, vector3 a_v3Position)
+{
+	m_lPositionX[a_uBody] = a_v3Position.x;
+	m_lPositionY[a_uBody] = a_v3Position.y;
+	m_lPositionZ[a_uBody] = a_v3Position.z;
+}
+vector3 MyPhysicsWorld::GetPosition(uint a_uBody)
+{
+	return vector3(m_lPositionX[a_uBody], m_lPositionY[a_uBody], m_lPositionZ[a_uBody]);
+}
+void MyPhysicsWorld::SetLastPosition(uint a_uBody, vector3 a_v3Position)
+{
+	m_lLastPositionX[a_uBody] = a_v3Position.x;
+	m_lLastPositionY[a_uBody] = a_v3Position.y;
+	m_lLastPositionZ[a_uBody] = a_v3Position.z;
+}
+vector3 MyPhysicsWorld::GetLastPosition(uint a_uBody)
+{
+	return vector3(m_lLastPositionX[a_uBody], m_lLastPositionY[a_uBody], m_lLastPositionZ[a_uBody]);
+}
+void MyPhysicsWorld::SetSize(uint a_uBody, vector3 a_v3Size)
+{
+	m_lSizeX[a_uBody] = a_v3Size.x;
+	m_lSizeY[a_uBody] = a_v3Size.y;
+	m_lSizeZ[a_uBody] = a_v3Size.z;
+}
+vector3 MyPhysicsWorld::GetSize(uint a_uBody)
+{
+	return vector3(m_lSizeX[a_uBody], m_lSizeY[a_uBody], m_lSizeZ[a_uBody]);
+}
+void MyPhysicsWorld::SetVelocity(uint a_uBody, vector3 a_v3Velocity)
+{
+	m_lVelocityX[a_uBody] = a_v3Velocity.x;
+	m_lVelocityY[a_uBody] = a_v3Velocity.y;
+	m_lVelocityZ[a_uBody] = a_v3Velocity.z;
+}
+vector3 MyPhysicsWorld::GetVelocity(uint a_uBody)
+{
+	return vector3(m_lVelocityX[a_uBody], m_lVelocityY[a_uBody], m_lVelocityZ[a_uBody]);
+}
+void MyPhysicsWorld::SetAcceleration(uint a_uBody, vector3 a_v3Acceleration)
+{
+	m_lAccelerationX[a_uBody] = a_v3Acceleration.x;
+	m_lAccelerationY[a_uBody] = a_v3Acceleration.y;
+	m_lAccelerationZ[a_uBody] = a_v3Acceleration.z;
+}
+vector3 MyPhysicsWorld::GetAcceleration(uint a_uBody)
+{
+	return vector3(m_lAccelerationX[a_uBody], m_lAccelerationY[a_uBody], m_lAccelerationZ[a_uBody]);
+}
+void MyPhysicsWorld::SetMass(uint a_uBody, float a_fMass) { m_lMass[a_uBody] = a_fMass; }
+float MyPhysicsWorld::GetMass(uint a_uBody) { return m_lMass[a_uBody]; }
+void MyPhysicsWorld::SetSimulated(uint a_uBody, bool a_bSimulated)
+{
+	m_lSimulated[a_uBody] = a_bSimulated ? 1.0f : 0.0f;
+	WakeBody(a_uBody);
+}
+bool MyPhysicsWorld::GetSimulated(uint a_uBody) { return m_lSimulated[a_uBody] != 0.0f; }
+void MyPhysicsWorld::SetContinuous(uint a_uBody, bool a_bContinuous) { m_lContinuous[a_uBody] = a_bContinuous; }
+bool MyPhysicsWorld::GetContinuous(uint a_uBody) { return m_lContinuous[a_uBody]; }
+matrix4 MyPhysicsWorld::GetModelMatrix(uint a_uBody) { return m_lModelMatrix[a_uBody]; }
+bool MyPhysicsWorld::IsAwake(uint a_uBody) { return m_lAwake[a_uBody] != 0.0f; }
+uint MyPhysicsWorld::GetSleepingCount(void) { return m_uSleepingCount; }
+uint MyPhysicsWorld::GetIslandCount(void) { return m_uIslandCount; }
+void MyPhysicsWorld::SetSleepThreshold(float a_fDistance, uint a_uSteps)
+{
+	m_fSleepDistance = a_fDistance;
+	m_uSleepSteps = a_uSteps;
+}
+void MyPhysicsWorld::UseSleeping(bool a_bUse)
+{
+	m_bSleeping = a_bUse;
+	if (m_bSleeping)
+		return;
+
+	//nothing sleeps anymore
+	while (!m_mSleepingIslandMap.empty())
+		WakeBody(m_mSleepingIslandMap.begin()->second[0]);
+}
+//Sleeping
+void MyPhysicsWorld::WakeBody(uint a_uBody)
+{
+	m_lStillSteps[a_uBody] = 0;
+	if (m_lAwake[a_uBody] != 0.0f)
+		return;
+
+	//the whole island wakes, a body alone would fall through the ones still holding it
+	std::map<uint, std::vector<uint>>::iterator it = m_mSleepingIslandMap.find(m_lSleepingIsland[a_uBody]);
+	if (it == m_mSleepingIslandMap.end())
+	{
+		m_lAwake[a_uBody] = 1.0f;
+		m_lSleepingIsland[a_uBody] = -1;
+		--m_uSleepingCount;
+		return;
+	}
+	for (uint uBody : it->second)
+	{
+		m_lAwake[uBody] = 1.0f;
+		m_lStillSteps[uBody] = 0;
+		m_lSleepingIsland[uBody] = -1;
+		--m_uSleepingCount;
+	}
+	m_mSleepingIslandMap.erase(it);
+}
+void MyPhysicsWorld::AddContact(uint a_uBody, uint a_uOther, vector3 a_v3Normal, float a_fDepth)
+{
+	//a contact wakes the islands of both bodies, the solver only moves awake bodies
+	if (m_lAwake[a_uBody] == 0.0f)
+		WakeBody(a_uBody);
+	if (m_lAwake[a_uOther] == 0.0f)
+		WakeBody(a_uOther);
+
+	Contact contact;
+	contact.m_uBody = a_uBody;
+	contact.m_uOther = a_uOther;
+	contact.m_v3Normal = a_v3Normal;
+	contact.m_fDepth = a_fDepth;
+	m_lContactList.push_back(contact);
+}
+void MyPhysicsWorld::SetSolverIterations(uint a_uIterations) { m_uIterations = a_uIterations; }
+uint MyPhysicsWorld::GetSolverIterations(void) { return m_uIterations; }
+void MyPhysicsWorld::UseThreads(bool a_bUse) { m_bThreads = a_bUse; }
+uint MyPhysicsWorld::FindIsland(uint a_uBody)
+{
+	while (m_lIsland[a_uBody] != a_uBody)
+	{
+		m_lIsland[a_uBody] = m_lIsland[m_lIsland[a_uBody]];
+		a_uBody = m_lIsland[a_uBody];
+	}
+	return a_uBody;
+}
+void MyPhysicsWorld::UpdateIslands(void)
+{
+	uint uSize = static_cast<uint>(m_lMass.size());
+	m_uIslandCount = 0;
+	if (!m_bSleeping)
+	{
+		m_lContactList.clear();
+		return;
+	}
+
+	//a still body counts its updates, what it moved is measured from the end of the last update as the
+	//contacts can undo what the velocity did; the islands are the ones the contacts were solved in
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] == 0.0f || m_lAwake[i] == 0.0f)
+			continue;
+		float fX = m_lPositionX[i] - m_lRestPositionX[i];
+		float fY = m_lPositionY[i] - m_lRestPositionY[i];
+		float fZ = m_lPositionZ[i] - m_lRestPositionZ[i];
+		float fMoved = std::sqrt(fX * fX + fY * fY + fZ * fZ);
+		m_lStillSteps[i] = fMoved < m_fSleepDistance ? m_lStillSteps[i] + 1 : 0;
+		m_lRestPositionX[i] = m_lPositionX[i];
+		m_lRestPositionY[i] = m_lPositionY[i];
+		m_lRestPositionZ[i] = m_lPositionZ[i];
+	}
+
+	m_lContactList.clear();
+
+	//an island is as still as its least still body
+	m_lIslandSteps.assign(uSize, static_cast<uint>(-1));
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] == 0.0f || m_lAwake[i] == 0.0f)
+			continue;
+		uint uIsland = FindIsland(i);
+		if (m_lIslandSteps[uIsland] == static_cast<uint>(-1))
+			++m_uIslandCount;
+		m_lIslandSteps[uIsland] = std::min(m_lIslandSteps[uIsland], m_lStillSteps[i]);
+	}
+
+	//the islands still for long enough go to sleep together, named in the order they are found
+	std::map<uint, uint> mNameMap;
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] == 0.0f || m_lAwake[i] == 0.0f)
+			continue;
+		uint uIsland = FindIsland(i);
+		if (m_lIslandSteps[uIsland] < m_uSleepSteps)
+			continue;
+		if (mNameMap.find(uIsland) == mNameMap.end())
+		{
+			mNameMap[uIsland] = m_uNextIsland++;
+			--m_uIslandCount;
+		}
+		uint uName = mNameMap[uIsland];
+		m_mSleepingIslandMap[uName].push_back(i);
+		m_lSleepingIsland[i] = uName;
+		m_lAwake[i] = 0.0f;
+		m_lVelocityX[i] = m_lVelocityY[i] = m_lVelocityZ[i] = 0.0f;
+		++m_uSleepingCount;
+	}
+}
+//Methods
+void MyPhysicsWorld::UpdateBody(uint a_uBody)
+{
+	IntegrateVelocity(a_uBody);
+	if (m_nSolverMode == SOLVER_IMPULSE)
+	{
+		IntegratePosition(a_uBody);
+		return;
+	}
+
+	m_lLastPositionX[a_uBody] = m_lPositionX[a_uBody];
+	m_lLastPositionY[a_uBody] = m_lPositionY[a_uBody];
+	m_lLastPositionZ[a_uBody] = m_lPositionZ[a_uBody];
+	float fStep = 1.0f / m_uSubsteps;
+	for (uint uSubstep = 0; uSubstep < m_uSubsteps; ++uSubstep)
+	{
+		PredictPosition(a_uBody, fStep);
+		ProjectGround(a_uBody);
+		DeriveVelocity(a_uBody, fStep);
+	}
+}
+void MyPhysicsWorld::IntegrateVelocity(uint a_uBody)
+{
+	uint i = a_uBody;
+
+	//gravity, the lighter the body the more it accelerates; the position solver adds it on each substep
+	if (m_lMass[i] < 0.01f)
+		m_lMass[i] = 0.01f;
+	float fGravity = m_nSolverMode == SOLVER_IMPULSE ? m_fGravity : 0.0f;
+	float fVelocityX = m_lVelocityX[i] + m_lAccelerationX[i];
+	float fVelocityY = m_lVelocityY[i] + (m_lAccelerationY[i] + fGravity / m_lMass[i]);
+	float fVelocityZ = m_lVelocityZ[i] + m_lAccelerationZ[i];
+
+	//limit the velocity, then slow it down by the friction and stop it if it is too slow
+	float fLength = std::sqrt(fVelocityX * fVelocityX + fVelocityY * fVelocityY + fVelocityZ * fVelocityZ);
+	float fScale = fLength > m_fMaxVelocity ? m_fMaxVelocity / fLength : 1.0f;
+	fScale *= 1.0f - m_fFriction;
+	fVelocityX *= fScale;
+	fVelocityY *= fScale;
+	fVelocityZ *= fScale;
+	fLength = std::sqrt(fVelocityX * fVelocityX + fVelocityY * fVelocityY + fVelocityZ * fVelocityZ);
+	if (fLength < m_fMinVelocity)
+		fVelocityX = fVelocityY = fVelocityZ = 0.0f;
+
+	//standing on the floor it cannot go down, so the contacts see it holding what is on top; the position
+	//solver has the ground as a constraint instead
+	if (m_nSolverMode == SOLVER_IMPULSE && m_lPositionY[i] <= 0.0f && fVelocityY < 0.0f)
+		fVelocityY = 0.0f;
+
+	m_lVelocityX[i] = fVelocityX;
+	m_lVelocityY[i] = fVelocityY;
+	m_lVelocityZ[i] = fVelocityZ;
+	m_lAccelerationX[i] = m_lAccelerationY[i] = m_lAccelerationZ[i] = 0.0f;
+}
+void MyPhysicsWorld::IntegratePosition(uint a_uBody)
+{
+	uint i = a_uBody;
+	m_lLastPositionX[i] = m_lPositionX[i];
+	m_lLastPositionY[i] = m_lPositionY[i];
+	m_lLastPositionZ[i] = m_lPositionZ[i];
+
+	//the push of the contacts moves it without staying in its velocity
+	m_lPositionX[i] += m_lVelocityX[i] + m_lPushX[i];
+	m_lPositionY[i] += m_lVelocityY[i] + m_lPushY[i];
+	m_lPositionZ[i] += m_lVelocityZ[i] + m_lPushZ[i];
+	m_lPushX[i] = m_lPushY[i] = m_lPushZ[i] = 0.0f;
+
+	//the floor stops it
+	if (m_lPositionY[i] <= 0.0f)
+	{
+		m_lPositionY[i] = 0.0f;
+		m_lVelocityY[i] = 0.0f;
+	}
+}
+void MyPhysicsWorld::IntegrateVelocities(void)
+{
+	uint uSize = static_cast<uint>(m_lMass.size());
+	uint uFirst = 0;
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+	//four bodies at a time, the bodies that are not simulated or are sleeping are blended back to what they were
+	const __m128 mZero = _mm_setzero_ps();
+	const __m128 mOne = _mm_set1_ps(1.0f);
+	const __m128 mMinMass = _mm_set1_ps(0.01f);
+	const __m128 mGravity = _mm_set1_ps(m_nSolverMode == SOLVER_IMPULSE ? m_fGravity : 0.0f);
+	const __m128 mFloor = m_nSolverMode == SOLVER_IMPULSE ? _mm_cmpeq_ps(mZero, mZero) : mZero;
+	const __m128 mMaxVelocity = _mm_set1_ps(m_fMaxVelocity);
+	const __m128 mFriction = _mm_set1_ps(1.0f - m_fFriction);
+	const __m128 mMinVelocity = _mm_set1_ps(m_fMinVelocity);
+	for (; uFirst + 4 <= uSize; uFirst += 4)
+	{
+		uint i = uFirst;
+		__m128 mSimulated = _mm_and_ps(_mm_cmpneq_ps(_mm_loadu_ps(&m_lSimulated[i]), mZero), _mm_cmpneq_ps(_mm_loadu_ps(&m_lAwake[i]), mZero));
+		__m128 mVelocityX = _mm_loadu_ps(&m_lVelocityX[i]);
+		__m128 mVelocityY = _mm_loadu_ps(&m_lVelocityY[i]);
+		__m128 mVelocityZ = _mm_loadu_ps(&m_lVelocityZ[i]);
+		__m128 mAccelerationX = _mm_loadu_ps(&m_lAccelerationX[i]);
+		__m128 mAccelerationY = _mm_loadu_ps(&m_lAccelerationY[i]);
+		__m128 mAccelerationZ = _mm_loadu_ps(&m_lAccelerationZ[i]);
+		__m128 mMass = _mm_loadu_ps(&m_lMass[i]);
+
+		//gravity, the lighter the body the more it accelerates
+		__m128 mNewMass = _mm_max_ps(mMass, mMinMass);
+		__m128 mNewX = _mm_add_ps(mVelocityX, mAccelerationX);
+		__m128 mNewY = _mm_add_ps(mVelocityY, _mm_add_ps(mAccelerationY, _mm_div_ps(mGravity, mNewMass)));
+		__m128 mNewZ = _mm_add_ps(mVelocityZ, mAccelerationZ);
+
+		//limit the velocity, then slow it down by the friction and stop it if it is too slow
+		__m128 mLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(mNewX, mNewX), _mm_mul_ps(mNewY, mNewY)), _mm_mul_ps(mNewZ, mNewZ)));
+		__m128 mFast = _mm_cmpgt_ps(mLength, mMaxVelocity);
+		__m128 mScale = _mm_or_ps(_mm_and_ps(mFast, _mm_div_ps(mMaxVelocity, mLength)), _mm_andnot_ps(mFast, mOne));
+		mScale = _mm_mul_ps(mScale, mFriction);
+		mNewX = _mm_mul_ps(mNewX, mScale);
+		mNewY = _mm_mul_ps(mNewY, mScale);
+		mNewZ = _mm_mul_ps(mNewZ, mScale);
+		mLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(mNewX, mNewX), _mm_mul_ps(mNewY, mNewY)), _mm_mul_ps(mNewZ, mNewZ)));
+		__m128 mMoving = _mm_cmpge_ps(mLength, mMinVelocity);
+		mNewX = _mm_and_ps(mNewX, mMoving);
+		mNewY = _mm_and_ps(mNewY, mMoving);
+		mNewZ = _mm_and_ps(mNewZ, mMoving);
+
+		//standing on the floor it cannot go down
+		__m128 mStanding = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&m_lPositionY[i]), mZero), _mm_cmplt_ps(mNewY, mZero));
+		mStanding = _mm_and_ps(mStanding, mFloor);
+		mNewY = _mm_andnot_ps(mStanding, mNewY);
+
+		_mm_storeu_ps(&m_lVelocityX[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewX), _mm_andnot_ps(mSimulated, mVelocityX)));
+		_mm_storeu_ps(&m_lVelocityY[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewY), _mm_andnot_ps(mSimulated, mVelocityY)));
+		_mm_storeu_ps(&m_lVelocityZ[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewZ), _mm_andnot_ps(mSimulated, mVelocityZ)));
+		_mm_storeu_ps(&m_lAccelerationX[i], _mm_andnot_ps(mSimulated, mAccelerationX));
+		_mm_storeu_ps(&m_lAccelerationY[i], _mm_andnot_ps(mSimulated, mAccelerationY));
+		_mm_storeu_ps(&m_lAccelerationZ[i], _mm_andnot_ps(mSimulated, mAccelerationZ));
+		_mm_storeu_ps(&m_lMass[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewMass), _mm_andnot_ps(mSimulated, mMass)));
+	}
+#endif
+	//what did not fill a group of four, or all of them without the instructions
+	for (uint i = uFirst; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] != 0.0f && m_lAwake[i] != 0.0f)
+			IntegrateVelocity(i);
+	}
+}
+void MyPhysicsWorld::IntegratePositions(void)
+{
+	uint uSize = static_cast<uint>(m_lMass.size());
+	uint uFirst = 0;
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+	const __m128 mZero = _mm_setzero_ps();
+	for (; uFirst + 4 <= uSize; uFirst += 4)
+	{
+		uint i = uFirst;
+		__m128 mSimulated = _mm_and_ps(_mm_cmpneq_ps(_mm_loadu_ps(&m_lSimulated[i]), mZero), _mm_cmpneq_ps(_mm_loadu_ps(&m_lAwake[i]), mZero));
+		__m128 mPositionX = _mm_loadu_ps(&m_lPositionX[i]);
+		__m128 mPositionY = _mm_loadu_ps(&m_lPositionY[i]);
+		__m128 mPositionZ = _mm_loadu_ps(&m_lPositionZ[i]);
+		__m128 mVelocityY = _mm_loadu_ps(&m_lVelocityY[i]);
+
+		//the push of the contacts moves it without staying in its velocity
+		__m128 mNewPositionX = _mm_add_ps(mPositionX, _mm_add_ps(_mm_loadu_ps(&m_lVelocityX[i]), _mm_loadu_ps(&m_lPushX[i])));
+		__m128 mNewPositionY = _mm_add_ps(mPositionY, _mm_add_ps(mVelocityY, _mm_loadu_ps(&m_lPushY[i])));
+		__m128 mNewPositionZ = _mm_add_ps(mPositionZ, _mm_add_ps(_mm_loadu_ps(&m_lVelocityZ[i]), _mm_loadu_ps(&m_lPushZ[i])));
+
+		//the floor stops it
+		__m128 mFloor = _mm_cmple_ps(mNewPositionY, mZero);
+		mNewPositionY = _mm_andnot_ps(mFloor, mNewPositionY);
+		__m128 mNewY = _mm_andnot_ps(mFloor, mVelocityY);
+
+		_mm_storeu_ps(&m_lLastPositionX[i], _mm_or_ps(_mm_and_ps(mSimulated, mPositionX), _mm_andnot_ps(mSimulated, _mm_loadu_ps(&m_lLastPositionX[i]))));
+		_mm_storeu_ps(&m_lLastPositionY[i], _mm_or_ps(_mm_and_ps(mSimulated, mPositionY), _mm_andnot_ps(mSimulated, _mm_loadu_ps(&m_lLastPositionY[i]))));
+		_mm_storeu_ps(&m_lLastPositionZ[i], _mm_or_ps(_mm_and_ps(mSimulated, mPositionZ), _mm_andnot_ps(mSimulated, _mm_loadu_ps(&m_lLastPositionZ[i]))));
+		_mm_storeu_ps(&m_lPositionX[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewPositionX), _mm_andnot_ps(mSimulated, mPositionX)));
+		_mm_storeu_ps(&m_lPositionY[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewPositionY), _mm_andnot_ps(mSimulated, mPositionY)));
+		_mm_storeu_ps(&m_lPositionZ[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewPositionZ), _mm_andnot_ps(mSimulated, mPositionZ)));
+		_mm_storeu_ps(&m_lVelocityY[i], _mm_or_ps(_mm_and_ps(mSimulated, mNewY), _mm_andnot_ps(mSimulated, mVelocityY)));
+		_mm_storeu_ps(&m_lPushX[i], mZero);
+		_mm_storeu_ps(&m_lPushY[i], mZero);
+		_mm_storeu_ps(&m_lPushZ[i], mZero);
+	}
+#endif
+	for (uint i = uFirst; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] != 0.0f && m_lAwake[i] != 0.0f)
+			IntegratePosition(i);
+		else
+			m_lPushX[i] = m_lPushY[i] = m_lPushZ[i] = 0.0f;
+	}
+}
+float MyPhysicsWorld::GetInverseMass(uint a_uBody, vector3 a_v3Push)
+{
+	//the world does not move it, so nothing can push it
+	if (m_lSimulated[a_uBody] == 0.0f)
+		return 0.0f;
+
+	//on the floor and pushed down, the floor holds it like if it had infinite mass; the position solver
+	//pushes it into the ground and projects it back out
+	if (m_nSolverMode == SOLVER_IMPULSE && m_lPositionY[a_uBody] <= 0.0f && a_v3Push.y < -0.5f)
+		return 0.0f;
+
+	//check minimum mass
+	float fMass = m_lMass[a_uBody];
+	if (fMass < 0.01f)
+		fMass = 0.01f;
+	return 1.0f / fMass;
+}
+void MyPhysicsWorld::ApplyImpulse(Contact const& a_Contact, vector3 a_v3Impulse)
+{
+	//a body that cannot move is not written, so the threads solving other islands can read it
+	uint uBody = a_Contact.m_uBody;
+	uint uOther = a_Contact.m_uOther;
+	if (a_Contact.m_fInvMass != 0.0f)
+	{
+		m_lVelocityX[uBody] -= a_v3Impulse.x * a_Contact.m_fInvMass;
+		m_lVelocityY[uBody] -= a_v3Impulse.y * a_Contact.m_fInvMass;
+		m_lVelocityZ[uBody] -= a_v3Impulse.z * a_Contact.m_fInvMass;
+	}
+	if (a_Contact.m_fOtherInvMass != 0.0f)
+	{
+		m_lVelocityX[uOther] += a_v3Impulse.x * a_Contact.m_fOtherInvMass;
+		m_lVelocityY[uOther] += a_v3Impulse.y * a_Contact.m_fOtherInvMass;
+		m_lVelocityZ[uOther] += a_v3Impulse.z * a_Contact.m_fOtherInvMass;
+	}
+}
+void MyPhysicsWorld::PrepareContact(Contact& a_Contact)
+{
+	uint uBody = a_Contact.m_uBody;
+	uint uOther = a_Contact.m_uOther;
+	vector3 v3Normal = a_Contact.m_v3Normal;
+	a_Contact.m_fInvMass = GetInverseMass(uBody, -v3Normal);
+	a_Contact.m_fOtherInvMass = GetInverseMass(uOther, v3Normal);
+	float fInvMassSum = a_Contact.m_fInvMass + a_Contact.m_fOtherInvMass;
+	a_Contact.m_fMass = fInvMassSum > 0.0f ? 1.0f / fInvMassSum : 0.0f;
+
+	//two directions along the surface for the friction
+	vector3 v3Axis = glm::abs(v3Normal.x) < 0.57f ? AXIS_X : AXIS_Y;
+	a_Contact.m_v3Tangent[0] = glm::normalize(glm::cross(v3Normal, v3Axis));
+	a_Contact.m_v3Tangent[1] = glm::cross(v3Normal, a_Contact.m_v3Tangent[0]);
+
+	//only a fast approach bounces, a resting contact would never settle
+	float fApproach = glm::dot(GetVelocity(uOther) - GetVelocity(uBody), v3Normal);
+	a_Contact.m_fBounce = fApproach < -m_fBounceVelocity ? -m_fRestitution * fApproach : 0.0f;
+
+	//the impulse the pair ended with last update is a good guess for this one
+	std::pair<uint, uint> key(std::min(uBody, uOther), std::max(uBody, uOther));
+	std::map<std::pair<uint, uint>, vector3>::const_iterator it = m_mImpulseMap.find(key);
+	if (it == m_mImpulseMap.end() || a_Contact.m_fMass == 0.0f)
+		return;
+	vector3 v3Impulse = uBody < uOther ? it->second : -it->second;
+	a_Contact.m_fImpulse = glm::max(glm::dot(v3Impulse, v3Normal), 0.0f);
+	float fMaxFriction = m_fSurfaceFriction * a_Contact.m_fImpulse;
+	for (uint t = 0; t < 2; ++t)
+		a_Contact.m_fTangentImpulse[t] = glm::clamp(glm::dot(v3Impulse, a_Contact.m_v3Tangent[t]), -fMaxFriction, fMaxFriction);
+	ApplyImpulse(a_Contact, v3Normal * a_Contact.m_fImpulse +
+		a_Contact.m_v3Tangent[0] * a_Contact.m_fTangentImpulse[0] + a_Contact.m_v3Tangent[1] * a_Contact.m_fTangentImpulse[1]);
+}
+void MyPhysicsWorld::SolveVelocity(Contact& a_Contact)
+{
+	if (a_Contact.m_fMass == 0.0f)
+		return;
+	uint uBody = a_Contact.m_uBody;
+	uint uOther = a_Contact.m_uOther;
+
+	//friction, it can hold as much as the normal impulse lets it
+	float fMaxFriction = m_fSurfaceFriction * a_Contact.m_fImpulse;
+	for (uint t = 0; t < 2; ++t)
+	{
+		vector3 v3Tangent = a_Contact.m_v3Tangent[t];
+		float fSlide = glm::dot(GetVelocity(uOther) - GetVelocity(uBody), v3Tangent);
+		float fImpulse = glm::clamp(a_Contact.m_fTangentImpulse[t] - fSlide * a_Contact.m_fMass, -fMaxFriction, fMaxFriction);
+		ApplyImpulse(a_Contact, v3Tangent * (fImpulse - a_Contact.m_fTangentImpulse[t]));
+		a_Contact.m_fTangentImpulse[t] = fImpulse;
+	}
+
+	//the bodies cannot move into each other, they can only be pushed apart
+	vector3 v3Normal = a_Contact.m_v3Normal;
+	float fApproach = glm::dot(GetVelocity(uOther) - GetVelocity(uBody), v3Normal);
+	float fImpulse = glm::max(a_Contact.m_fImpulse + (a_Contact.m_fBounce - fApproach) * a_Contact.m_fMass, 0.0f);
+	ApplyImpulse(a_Contact, v3Normal * (fImpulse - a_Contact.m_fImpulse));
+	a_Contact.m_fImpulse = fImpulse;
+}
+void MyPhysicsWorld::SolvePush(Contact& a_Contact)
+{
+	if (a_Contact.m_fMass == 0.0f)
+		return;
+	uint uBody = a_Contact.m_uBody;
+	uint uOther = a_Contact.m_uOther;
+	vector3 v3Normal = a_Contact.m_v3Normal;
+	float fWanted = m_fPushFactor * glm::max(a_Contact.m_fDepth - m_fSlop, 0.0f);
+	vector3 v3Push = vector3(m_lPushX[uOther] - m_lPushX[uBody], m_lPushY[uOther] - m_lPushY[uBody], m_lPushZ[uOther] - m_lPushZ[uBody]);
+	float fImpulse = glm::max(a_Contact.m_fPushImpulse + (fWanted - glm::dot(v3Push, v3Normal)) * a_Contact.m_fMass, 0.0f);
+	vector3 v3Impulse = v3Normal * (fImpulse - a_Contact.m_fPushImpulse);
+	a_Contact.m_fPushImpulse = fImpulse;
+	if (a_Contact.m_fInvMass != 0.0f)
+	{
+		m_lPushX[uBody] -= v3Impulse.x * a_Contact.m_fInvMass;
+		m_lPushY[uBody] -= v3Impulse.y * a_Contact.m_fInvMass;
+		m_lPushZ[uBody] -= v3Impulse.z * a_Contact.m_fInvMass;
+	}
+	if (a_Contact.m_fOtherInvMass != 0.0f)
+	{
+		m_lPushX[uOther] += v3Impulse.x * a_Contact.m_fOtherInvMass;
+		m_lPushY[uOther] += v3Impulse.y * a_Contact.m_fOtherInvMass;
+		m_lPushZ[uOther] += v3Impulse.z * a_Contact.m_fOtherInvMass;
+	}
+}
+void MyPhysicsWorld::BuildIslands(void)
+{
+	uint uSize = static_cast<uint>(m_lMass.size());
+	uint uContactCount = static_cast<uint>(m_lContactList.size());
+
+	//each body starts as an island of its own, the contacts join the bodies the world moves; the ones
+	//it does not move are only read by the solver, so they do not join anything
+	m_lIsland.resize(uSize);
+	for (uint i = 0; i < uSize; ++i)
+		m_lIsland[i] = i;
+	for (uint c = 0; c < uContactCount; ++c)
+	{
+		uint uBody = m_lContactList[c].m_uBody;
+		uint uOther = m_lContactList[c].m_uOther;
+		if (m_lSimulated[uBody] == 0.0f || m_lSimulated[uOther] == 0.0f)
+			continue;
+		uint uIsland = FindIsland(uBody);
+		uint uOtherIsland = FindIsland(uOther);
+		if (uIsland != uOtherIsland)
+			m_lIsland[std::max(uIsland, uOtherIsland)] = std::min(uIsland, uOtherIsland);
+	}
+
+	//the contacts of each island together, the islands in the order their first contact was added
+	m_lContactIsland.assign(uContactCount, static_cast<uint>(-1));
+	m_lIslandIndex.assign(uSize, static_cast<uint>(-1));
+	m_lSolverIslandList.clear();
+	for (uint c = 0; c < uContactCount; ++c)
+	{
+		uint uBody = m_lContactList[c].m_uBody;
+		if (m_lSimulated[uBody] == 0.0f)
+			uBody = m_lContactList[c].m_uOther;
+		if (m_lSimulated[uBody] == 0.0f)
+			continue;
+		uint uIsland = FindIsland(uBody);
+		if (m_lIslandIndex[uIsland] == static_cast<uint>(-1))
+		{
+			m_lIslandIndex[uIsland] = static_cast<uint>(m_lSolverIslandList.size());
+			m_lSolverIslandList.push_back(SolverIsland());
+		}
+		m_lContactIsland[c] = m_lIslandIndex[uIsland];
+		++m_lSolverIslandList[m_lContactIsland[c]].m_uEnd;
+	}
+	uint uFirst = 0;
+	for (SolverIsland& island : m_lSolverIslandList)
+	{
+		island.m_uFirst = uFirst;
+		uFirst += island.m_uEnd;
+		island.m_uEnd = island.m_uFirst;
+	}
+	m_lIslandContact.resize(uFirst);
+	for (uint c = 0; c < uContactCount; ++c)
+	{
+		if (m_lContactIsland[c] != static_cast<uint>(-1))
+			m_lIslandContact[m_lSolverIslandList[m_lContactIsland[c]].m_uEnd++] = c;
+	}
+
+	//the big islands are split by colour, the contacts of a colour share no body the solver writes
+	m_lColourStart.clear();
+	for (SolverIsland& island : m_lSolverIslandList)
+	{
+		island.m_uFirstColour = island.m_uEndColour = static_cast<uint>(m_lColourStart.size());
+		if (island.m_uEnd - island.m_uFirst < m_uColourSize)
+			continue;
+		ColourIsland(island);
+	}
+}
+void MyPhysicsWorld::ColourIsland(SolverIsland& a_Island)
+{
+	//greedy, each contact takes the first colour neither of its bodies has; a body in more contacts than
+	//there are colours sends the rest to the last one, which is solved in order
+	const uint uLastColour = 31;
+	m_lColourMask.resize(m_lMass.size(), 0);
+	m_lContactColour.resize(m_lContactList.size());
+	std::vector<uint> lCount(uLastColour + 1, 0);
+	for (uint i = a_Island.m_uFirst; i < a_Island.m_uEnd; ++i)
+	{
+		Contact const& contact = m_lContactList[m_lIslandContact[i]];
+		uint uUsed = m_lColourMask[contact.m_uBody] | m_lColourMask[contact.m_uOther];
+		uint uColour = 0;
+		while (uColour < uLastColour && (uUsed & (1u << uColour)) != 0)
+			++uColour;
+		if (m_lSimulated[contact.m_uBody] != 0.0f)
+			m_lColourMask[contact.m_uBody] |= 1u << uColour;
+		if (m_lSimulated[contact.m_uOther] != 0.0f)
+			m_lColourMask[contact.m_uOther] |= 1u << uColour;
+		m_lContactColour[m_lIslandContact[i]] = uColour;
+		++lCount[uColour];
+	}
+
+	//the contacts of the island ordered by colour, keeping their order within each colour
+	uint uColourCount = uLastColour + 1;
+	while (uColourCount > 0 && lCount[uColourCount - 1] == 0)
+		--uColourCount;
+	std::vector<uint> lStart(uColourCount, a_Island.m_uFirst);
+	for (uint k = 1; k < uColourCount; ++k)
+		lStart[k] = lStart[k - 1] + lCount[k - 1];
+	for (uint k = 0; k < uColourCount; ++k)
+		m_lColourStart.push_back(lStart[k]);
+	m_lColourStart.push_back(a_Island.m_uEnd);
+	a_Island.m_uEndColour = a_Island.m_uFirstColour + uColourCount;
+
+	std::vector<uint> lContact(m_lIslandContact.begin() + a_Island.m_uFirst, m_lIslandContact.begin() + a_Island.m_uEnd);
+	for (uint c : lContact)
+	{
+		m_lIslandContact[lStart[m_lContactColour[c]]++] = c;
+		m_lColourMask[m_lContactList[c].m_uBody] = 0;
+		m_lColourMask[m_lContactList[c].m_uOther] = 0;
+	}
+}
+void MyPhysicsWorld::SolveRange(uint a_uFirst, uint a_uEnd, ContactStep a_pStep)
+{
+	for (uint i = a_uFirst; i < a_uEnd; ++i)
+		(this->*a_pStep)(m_lContactList[m_lIslandContact[i]]);
+}
+void MyPhysicsWorld::SolveColours(SolverIsland const& a_Island, ContactStep a_pStep)
+{
+	MyThreadPool* pPool = m_bThreads ? MyThreadPool::GetInstance() : nullptr;
+	for (uint k = a_Island.m_uFirstColour; k < a_Island.m_uEndColour; ++k)
+	{
+		uint uFirst = m_lColourStart[k];
+		uint uEnd = m_lColourStart[k + 1];
+
+		//the last colour can have contacts sharing bodies, and a small colour is not worth the threads
+		bool bShared = k + 1 == a_Island.m_uEndColour && k - a_Island.m_uFirstColour == 31;
+		if (pPool == nullptr || bShared || uEnd - uFirst < 2 * m_uBatchSize)
+		{
+			SolveRange(uFirst, uEnd, a_pStep);
+			continue;
+		}
+		for (uint uBatch = uFirst; uBatch < uEnd; uBatch += m_uBatchSize)
+		{
+			uint uBatchEnd = std::min(uBatch + m_uBatchSize, uEnd);
+			pPool->Run([this, uBatch, uBatchEnd, a_pStep] { SolveRange(uBatch, uBatchEnd, a_pStep); });
+		}
+		pPool->Wait();
+	}
+}
+void MyPhysicsWorld::SolveIslands(ContactStep a_pStep)
+{
+	//the islands share no body the solver writes, so they are solved at the same time; the small ones
+	//are given to the threads in batches and the contacts of each one are solved in the order they came
+	MyThreadPool* pPool = m_bThreads ? MyThreadPool::GetInstance() : nullptr;
+	uint uIslandCount = static_cast<uint>(m_lSolverIslandList.size());
+	uint uBatchFirst = 0;
+	uint uBatchContacts = 0;
+	for (uint i = 0; i < uIslandCount; ++i)
+	{
+		SolverIsland const& island = m_lSolverIslandList[i];
+		if (island.m_uFirstColour == island.m_uEndColour)
+			uBatchContacts += island.m_uEnd - island.m_uFirst;
+		if (uBatchContacts < m_uBatchSize && i + 1 < uIslandCount)
+			continue;
+		uint uBatchEnd = i + 1;
+		if (pPool == nullptr)
+			SolveBatch(uBatchFirst, uBatchEnd, a_pStep);
+		else
+			pPool->Run([this, uBatchFirst, uBatchEnd, a_pStep] { SolveBatch(uBatchFirst, uBatchEnd, a_pStep); });
+		uBatchFirst = uBatchEnd;
+		uBatchContacts = 0;
+	}
+
+	//the big islands colour by colour, each colour split between the threads; waiting for a colour
+	//also helps with the small islands still queued
+	for (SolverIsland const& island : m_lSolverIslandList)
+	{
+		if (island.m_uFirstColour != island.m_uEndColour)
+			SolveColours(island, a_pStep);
+	}
+	if (pPool != nullptr)
+		pPool->Wait();
+}
+void MyPhysicsWorld::SolveContacts(void)
+{
+	BuildIslands();
+	SolveIslands(&MyPhysicsWorld::PrepareContact);
+	for (uint uIteration = 0; uIteration < m_uIterations; ++uIteration)
+		SolveIslands(&MyPhysicsWorld::SolveVelocity);
+	for (uint uIteration = 0; uIteration < m_uIterations; ++uIteration)
+		SolveIslands(&MyPhysicsWorld::SolvePush);
+
+	//keep the impulses for the next update, the pairs that are no longer in contact are forgotten
+	m_mImpulseMap.clear();
+	for (Contact const& contact : m_lContactList)
+	{
+		if (contact.m_fMass == 0.0f)
+			continue;
+		vector3 v3Impulse = contact.m_v3Normal * contact.m_fImpulse +
+			contact.m_v3Tangent[0] * contact.m_fTangentImpulse[0] + contact.m_v3Tangent[1] * contact.m_fTangentImpulse[1];
+		std::pair<uint, uint> key(std::min(contact.m_uBody, contact.m_uOther), std::max(contact.m_uBody, contact.m_uOther));
+		m_mImpulseMap[key] = contact.m_uBody < contact.m_uOther ? v3Impulse : -v3Impulse;
+	}
+}
+void MyPhysicsWorld::SolveBatch(uint a_uFirst, uint a_uEnd, ContactStep a_pStep)
+{
+	for (uint i = a_uFirst; i < a_uEnd; ++i)
+	{
+		SolverIsland const& island = m_lSolverIslandList[i];
+		if (island.m_uFirstColour == island.m_uEndColour)
+			SolveRange(island.m_uFirst, island.m_uEnd, a_pStep);
+	}
+}
+void MyPhysicsWorld::PrepareProjection(Contact& a_Contact)
+{
+	a_Contact.m_fInvMass = GetInverseMass(a_Contact.m_uBody, -a_Contact.m_v3Normal);
+	a_Contact.m_fOtherInvMass = GetInverseMass(a_Contact.m_uOther, a_Contact.m_v3Normal);
+	float fInvMassSum = a_Contact.m_fInvMass + a_Contact.m_fOtherInvMass;
+	a_Contact.m_fMass = fInvMassSum > 0.0f ? 1.0f / fInvMassSum : 0.0f;
+}
+void MyPhysicsWorld::ApplyCorrection(Contact const& a_Contact, vector3 a_v3Correction)
+{
+	uint uBody = a_Contact.m_uBody;
+	uint uOther = a_Contact.m_uOther;
+	if (a_Contact.m_fInvMass != 0.0f)
+	{
+		m_lPositionX[uBody] -= a_v3Correction.x * a_Contact.m_fInvMass;
+		m_lPositionY[uBody] -= a_v3Correction.y * a_Contact.m_fInvMass;
+		m_lPositionZ[uBody] -= a_v3Correction.z * a_Contact.m_fInvMass;
+	}
+	if (a_Contact.m_fOtherInvMass != 0.0f)
+	{
+		m_lPositionX[uOther] += a_v3Correction.x * a_Contact.m_fOtherInvMass;
+		m_lPositionY[uOther] += a_v3Correction.y * a_Contact.m_fOtherInvMass;
+		m_lPositionZ[uOther] += a_v3Correction.z * a_Contact.m_fOtherInvMass;
+	}
+}
+float MyPhysicsWorld::GetProjectedDepth(Contact const& a_Contact)
+{
+	//the depth was measured where the bodies started the update, what they moved since changes it;
+	//the bodies that cannot move are left out as they are not predicted
+	vector3 v3Moved = ZERO_V3;
+	if (a_Contact.m_fInvMass != 0.0f)
+		v3Moved -= GetPosition(a_Contact.m_uBody) - GetLastPosition(a_Contact.m_uBody);
+	if (a_Contact.m_fOtherInvMass != 0.0f)
+		v3Moved += GetPosition(a_Contact.m_uOther) - GetLastPosition(a_Contact.m_uOther);
+	return a_Contact.m_fDepth - glm::dot(v3Moved, a_Contact.m_v3Normal);
+}
+void MyPhysicsWorld::Prestabilize(Contact& a_Contact)
+{
+	if (a_Contact.m_fMass == 0.0f)
+		return;
+	float fDepth = GetProjectedDepth(a_Contact) - m_fSlop;
+	if (fDepth > 0.0f)
+		ApplyCorrection(a_Contact, a_Contact.m_v3Normal * (fDepth * a_Contact.m_fMass));
+}
+void MyPhysicsWorld::KeepDepth(Contact& a_Contact)
+{
+	if (a_Contact.m_fMass != 0.0f)
+		a_Contact.m_fKeptDepth = std::max(GetProjectedDepth(a_Contact), m_fSlop);
+}
+void MyPhysicsWorld::ProjectContact(Contact& a_Contact)
+{
+	if (a_Contact.m_fMass == 0.0f)
+		return;
+	uint uBody = a_Contact.m_uBody;
+	uint uOther = a_Contact.m_uOther;
+	vector3 v3Normal = a_Contact.m_v3Normal;
+
+	//only what goes deeper than the overlap left before the substeps is taken out here
+	float fDepth = GetProjectedDepth(a_Contact) - a_Contact.m_fKeptDepth;
+	if (fDepth <= 0.0f)
+		return;
+
+	//out of each other, the compliance makes the contact soft
+	float fStep = 1.0f / m_uSubsteps;
+	float fCorrection = fDepth / (a_Contact.m_fInvMass + a_Contact.m_fOtherInvMass + m_fCompliance / (fStep * fStep));
+	ApplyCorrection(a_Contact, v3Normal * fCorrection);
+
+	//friction takes back what they slid along each other in this substep, as much as the push allows
+	vector3 v3Slide = ZERO_V3;
+	if (a_Contact.m_fInvMass != 0.0f)
+		v3Slide -= GetPosition(uBody) - vector3(m_lSubstepX[uBody], m_lSubstepY[uBody], m_lSubstepZ[uBody]);
+	if (a_Contact.m_fOtherInvMass != 0.0f)
+		v3Slide += GetPosition(uOther) - vector3(m_lSubstepX[uOther], m_lSubstepY[uOther], m_lSubstepZ[uOther]);
+	v3Slide -= v3Normal * glm::dot(v3Slide, v3Normal);
+	float fSlide = glm::length(v3Slide);
+	if (fSlide == 0.0f)
+		return;
+	float fFriction = std::min(fSlide * a_Contact.m_fMass, m_fSurfaceFriction * fCorrection);
+	ApplyCorrection(a_Contact, v3Slide * (-fFriction / fSlide));
+}
+void MyPhysicsWorld::PredictPosition(uint a_uBody, float a_fStep)
+{
+	uint i = a_uBody;
+	m_lSubstepX[i] = m_lPositionX[i];
+	m_lSubstepY[i] = m_lPositionY[i];
+	m_lSubstepZ[i] = m_lPositionZ[i];
+
+	m_lVelocityY[i] += m_fGravity / m_lMass[i] * a_fStep;
+	m_lPositionX[i] += m_lVelocityX[i] * a_fStep;
+	m_lPositionY[i] += m_lVelocityY[i] * a_fStep;
+	m_lPositionZ[i] += m_lVelocityZ[i] * a_fStep;
+}
+void MyPhysicsWorld::ProjectGround(uint a_uBody)
+{
+	uint i = a_uBody;
+	if (m_lPositionY[i] >= 0.0f)
+		return;
+
+	//out of the ground, with friction on what it slid along it
+	float fDepth = -m_lPositionY[i];
+	m_lPositionY[i] = 0.0f;
+	float fSlideX = m_lPositionX[i] - m_lSubstepX[i];
+	float fSlideZ = m_lPositionZ[i] - m_lSubstepZ[i];
+	float fSlide = std::sqrt(fSlideX * fSlideX + fSlideZ * fSlideZ);
+	if (fSlide == 0.0f)
+		return;
+	float fScale = std::min(m_fSurfaceFriction * fDepth, fSlide) / fSlide;
+	m_lPositionX[i] -= fSlideX * fScale;
+	m_lPositionZ[i] -= fSlideZ * fScale;
+}
+void MyPhysicsWorld::DeriveVelocity(uint a_uBody, float a_fStep)
+{
+	uint i = a_uBody;
+	m_lVelocityX[i] = (m_lPositionX[i] - m_lSubstepX[i]) / a_fStep;
+	m_lVelocityY[i] = (m_lPositionY[i] - m_lSubstepY[i]) / a_fStep;
+	m_lVelocityZ[i] = (m_lPositionZ[i] - m_lSubstepZ[i]) / a_fStep;
+}
+void MyPhysicsWorld::ProjectContacts(void)
+{
+	uint uSize = static_cast<uint>(m_lMass.size());
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] == 0.0f || m_lAwake[i] == 0.0f)
+			continue;
+		m_lLastPositionX[i] = m_lPositionX[i];
+		m_lLastPositionY[i] = m_lPositionY[i];
+		m_lLastPositionZ[i] = m_lPositionZ[i];
+	}
+	BuildIslands();
+	for (Contact& contact : m_lContactList)
+		PrepareProjection(contact);
+
+	//the overlap left from the last update is taken out before the substeps, as the velocity comes from
+	//what the bodies move in them and it would throw them apart; what one pass does not take out is kept
+	SolveIslands(&MyPhysicsWorld::Prestabilize);
+
+	//the ground too, or the first substep would throw up what was pushed into it
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_lSimulated[i] != 0.0f && m_lAwake[i] != 0.0f && m_lPositionY[i] < 0.0f)
+			m_lPositionY[i] = 0.0f;
+	}
+	SolveIslands(&MyPhysicsWorld::KeepDepth);
+
+	//each substep predicts where the bodies go, projects them out of each other and the ground and
+	//takes the velocity from what they moved
+	float fStep = 1.0f / m_uSubsteps;
+	for (uint uSubstep = 0; uSubstep < m_uSubsteps; ++uSubstep)
+	{
+		for (uint i = 0; i < uSize; ++i)
+		{
+			if (m_lSimulated[i] != 0.0f && m_lAwake[i] != 0.0f)
+				PredictPosition(i, fStep);
+		}
+		SolveIslands(&MyPhysicsWorld::ProjectContact);
+		for (uint i = 0; i < uSize; ++i)
+		{
+			if (m_lSimulated[i] == 0.0f || m_lAwake[i] == 0.0f)
+				continue;
+			ProjectGround(i);
+			DeriveVelocity(i, fStep);
+		}
+	}
+}
+void MyPhysicsWorld::SetSolverMode(eSolverMode a_nMode)
+{
+	//the impulses kept for the next update mean nothing to the other solver
+	m_nSolverMode = a_nMode;
+	m_mImpulseMap.clear();
+}
+eSolverMode MyPhysicsWorld::GetSolverMode(void) { return m_nSolverMode; }
+void MyPhysicsWorld::SetSubsteps(uint a_uSubsteps) { m_uSubsteps = a_uSubsteps > 0 ? a_uSubsteps : 1; }
+uint MyPhysicsWorld::GetSubsteps(void) { return m_uSubsteps; }
+void MyPhysicsWorld::UseDeterministicOrder(bool a_bUse) { m_bDeterministic = a_bUse; }
+void MyPhysicsWorld::SortContacts(void)
+{
+	//the smaller body first and the contacts by their bodies, so the order the entity manager found them
+	//in does not change the result
+	for (Contact& contact : m_lContactList)
+	{
+		if (contact.m_uBody < contact.m_uOther)
+			continue;
+		std::swap(contact.m_uBody, contact.m_uOther);
+		contact.m_v3Normal = -contact.m_v3Normal;
+	}
+	std::stable_sort(m_lContactList.begin(), m_lContactList.end(), [](Contact const& a_Contact, Contact const& a_Other)
+	{
+		if (a_Contact.m_uBody != a_Other.m_uBody)
+			return a_Contact.m_uBody < a_Other.m_uBody;
+		return a_Contact.m_uOther < a_Other.m_uOther;
+	});
+}
+//the snapshot is a list of blocks copied as they are in memory
+template <typename T>
+void WriteBlock(std::vector<char>& a_lBuffer, T const* a_pData, size_t a_uCount)
+{
+	size_t uOffset = a_lBuffer.size();
+	a_lBuffer.resize(uOffset + a_uCount * sizeof(T));
+	if (a_uCount > 0)
+		std::memcpy(&a_lBuffer[uOffset], a_pData, a_uCount * sizeof(T));
+}
+template <typename T>
+bool ReadBlock(std::vector<char> const& a_lBuffer, size_t& a_uOffset, T* a_pData, size_t a_uCount)
+{
+	if (a_uOffset + a_uCount * sizeof(T) > a_lBuffer.size())
+		return false;
+	if (a_uCount > 0)
+		std::memcpy(a_pData, &a_lBuffer[a_uOffset], a_uCount * sizeof(T));
+	a_uOffset += a_uCount * sizeof(T);
+	return true;
+}
+void MyPhysicsWorld::SaveSnapshot(std::vector<char>& a_lBuffer)
+{
+	uint uSize = static_cast<uint>(m_lMass.size());
+	std::vector<std::vector<float>*> const& lFloatArray = GetFloatArrays();
+
+	//how much of everything there is first, so the buffer is sized once
+	uint lCount[5] = { uSize, m_uBodyCount, static_cast<uint>(m_lFreeList.size()),
+		static_cast<uint>(m_mImpulseMap.size()), m_uNextIsland };
+	a_lBuffer.clear();
+	a_lBuffer.reserve(sizeof(lCount) + uSize * (lFloatArray.size() * sizeof(float) + 2 * sizeof(uint) + 1) +
+		lCount[2] * sizeof(uint) + lCount[3] * (2 * sizeof(uint) + sizeof(vector3)));
+	WriteBlock(a_lBuffer, lCount, 5);
+
+	//the bodies, the model matrices are left out as they come from the position and size
+	for (std::vector<float>* pArray : lFloatArray)
+		WriteBlock(a_lBuffer, pArray->data(), uSize);
+	WriteBlock(a_lBuffer, m_lStillSteps.data(), uSize);
+	WriteBlock(a_lBuffer, m_lSleepingIsland.data(), uSize);
+	for (uint i = 0; i < uSize; ++i)
+		a_lBuffer.push_back(m_lContinuous[i] ? 1 : 0);
+	WriteBlock(a_lBuffer, m_lFreeList.data(), m_lFreeList.size());
+
+	//the impulses the pairs in contact ended with, the solver starts from them
+	for (std::map<std::pair<uint, uint>, vector3>::const_iterator it = m_mImpulseMap.begin(); it != m_mImpulseMap.end(); ++it)
+	{
+		uint lPair[2] = { it->first.first, it->first.second };
+		WriteBlock(a_lBuffer, lPair, 2);
+		WriteBlock(a_lBuffer, &it->second, 1);
+	}
+}
+bool MyPhysicsWorld::LoadSnapshot(std::vector<char> const& a_lBuffer)
+{
+	//only a snapshot of the same bodies can be loaded
+	size_t uOffset = 0;
+	uint lCount[5];
+	if (!ReadBlock(a_lBuffer, uOffset, lCount, 5) || lCount[0] != m_lMass.size())
+		return false;
+	uint uSize = lCount[0];
+	std::vector<std::vector<float>*> const& lFloatArray = GetFloatArrays();
+	size_t uNeeded = sizeof(lCount) + uSize * (lFloatArray.size() * sizeof(float) + 2 * sizeof(uint) + 1) +
+		lCount[2] * sizeof(uint) + lCount[3] * (2 * sizeof(uint) + sizeof(vector3));
+	if (a_lBuffer.size() != uNeeded)
+		return false;
+
+	m_uBodyCount = lCount[1];
+	m_uNextIsland = lCount[4];
+	for (std::vector<float>* pArray : lFloatArray)
+		ReadBlock(a_lBuffer, uOffset, pArray->data(), uSize);
+	ReadBlock(a_lBuffer, uOffset, m_lStillSteps.data(), uSize);
+	ReadBlock(a_lBuffer, uOffset, m_lSleepingIsland.data(), uSize);
+	for (uint i = 0; i < uSize; ++i)
+		m_lContinuous[i] = a_lBuffer[uOffset++] != 0;
+	m_lFreeList.resize(lCount[2]);
+	ReadBlock(a_lBuffer, uOffset, m_lFreeList.data(), lCount[2]);
+
+	//the pairs were saved in order, so each one goes at the end of the map
+	m_mImpulseMap.clear();
+	for (uint c = 0; c < lCount[3]; ++c)
+	{
+		uint lPair[2];
+		vector3 v3Impulse;
+		ReadBlock(a_lBuffer, uOffset, lPair, 2);
+		ReadBlock(a_lBuffer, uOffset, &v3Impulse, 1);
+		m_mImpulseMap.emplace_hint(m_mImpulseMap.end(), std::pair<uint, uint>(lPair[0], lPair[1]), v3Impulse);
+	}
+
+	//the sleeping islands list their bodies in order, as they were put to sleep
+	m_mSleepingIslandMap.clear();
+	m_uSleepingCount = 0;
+	for (uint i = 0; i < uSize; ++i)
+	{
+		if (m_lSleepingIsland[i] == static_cast<uint>(-1))
+			continue;
+		m_mSleepingIslandMap[m_lSleepingIsland[i]].push_back(i);
+		++m_uSleepingCount;
+	}
+	m_lContactList.clear();
+	UpdateModelMatrices();
+	return true;
+}
+void MyPhysicsWorld::Update(void)
+{
+	//gravity and the forces first, so the contacts see where the bodies are going
+	IntegrateVelocities();
+	if (m_bDeterministic)
+		SortContacts();
+	if (m_nSolverMode == SOLVER_POSITION)
+	{
+		ProjectContacts();
+	}
+	else
+	{
+		SolveContacts();
+		IntegratePositions();
+	}
+
+	UpdateIslands();
+	UpdateModelMatrices();
+}
+void MyPhysicsWorld::UpdateModelMatrices(void)
+{
+	//translation times scale, written directly
+	uint uSize = static_cast<uint>(m_lMass.size());
+	for (uint i = 0; i < uSize; ++i)
+	{
+		matrix4& m4Model = m_lModelMatrix[i];
+		m4Model = matrix4(
+			m_lSizeX[i], 0.0f, 0.0f, 0.0f,
+			0.0f, m_lSizeY[i], 0.0f, 0.0f,
+			0.0f, 0.0f, m_lSizeZ[i], 0.0f,
+			m_lPositionX[i], m_lPositionY[i], m_lPositionZ[i], 1.0f);
+	}
+}
\ No newline at end of file
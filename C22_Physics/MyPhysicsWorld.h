@@ -0,0 +1,701 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+----------------------------------------------*/
+#ifndef __MYPHYSICSWORLD_H_
+#define __MYPHYSICSWORLD_H_
+
+#include "Simplex\Mesh\Model.h"
+
+namespace Simplex
+{
+
+//how the physics world solves the contacts
+enum eSolverMode
+{
+	SOLVER_IMPULSE = 0, //impulses on the velocities, then the bodies move
+	SOLVER_POSITION, //the bodies move in substeps and their positions are projected out of each other
+};
+
+//System Class
+class MyPhysicsWorld
+{
+	static MyPhysicsWorld* m_pInstance; // Singleton pointer
+
+	//two bodies touching on the last update, solved together with the rest of the contacts
+	struct Contact
+	{
+		uint m_uBody = 0; //body pushed against the normal
+		uint m_uOther = 0; //body pushed along the normal
+		vector3 m_v3Normal = ZERO_V3; //direction from the body to the other
+		vector3 m_v3Tangent[2]; //directions of the friction, along the surface
+		float m_fDepth = 0.0f; //how much the bodies go into each other
+		float m_fInvMass = 0.0f; //inverse mass of the body in this contact
+		float m_fOtherInvMass = 0.0f; //inverse mass of the other in this contact
+		float m_fMass = 0.0f; //mass the contact moves, 0 when neither body can move
+		float m_fBounce = 0.0f; //velocity the bodies separate with after a fast approach
+		float m_fImpulse = 0.0f; //normal impulse accumulated on this update
+		float m_fTangentImpulse[2] = { 0.0f, 0.0f }; //friction impulses accumulated on this update
+		float m_fPushImpulse = 0.0f; //impulse accumulated to push the bodies out of each other
+		float m_fKeptDepth = 0.0f; //overlap the position solver leaves in the substeps
+	};
+
+	//bodies joined by contacts, solved apart from the other islands
+	struct SolverIsland
+	{
+		uint m_uFirst = 0; //first of its contacts in the island contact list
+		uint m_uEnd = 0; //one after the last of its contacts
+		uint m_uFirstColour = 0; //first of its colours in the colour start list, none when it is small
+		uint m_uEndColour = 0; //one after its last colour
+	};
+
+	typedef void (MyPhysicsWorld::*ContactStep)(Contact& a_Contact); //what the solver does to one contact
+
+	//each quantity of the bodies lives in its own array so the update runs through memory in order,
+	//a body is an index in all of them
+	std::vector<float> m_lPositionX; //x of the position of each body
+	std::vector<float> m_lPositionY; //y of the position of each body
+	std::vector<float> m_lPositionZ; //z of the position of each body
+	std::vector<float> m_lVelocityX; //x of the velocity of each body
+	std::vector<float> m_lVelocityY; //y of the velocity of each body
+	std::vector<float> m_lVelocityZ; //z of the velocity of each body
+	std::vector<float> m_lAccelerationX; //x of the acceleration of each body
+	std::vector<float> m_lAccelerationY; //y of the acceleration of each body
+	std::vector<float> m_lAccelerationZ; //z of the acceleration of each body
+	std::vector<float> m_lLastPositionX; //x of the position of each body before the last update
+	std::vector<float> m_lLastPositionY; //y of the position of each body before the last update
+	std::vector<float> m_lLastPositionZ; //z of the position of each body before the last update
+	std::vector<float> m_lSizeX; //x of the size of each body
+	std::vector<float> m_lSizeY; //y of the size of each body
+	std::vector<float> m_lSizeZ; //z of the size of each body
+	std::vector<float> m_lMass; //mass of each body
+	std::vector<float> m_lSimulated; //1 for the bodies the update moves, 0 for the rest
+	std::vector<float> m_lAwake; //1 for the bodies that are awake, 0 for the sleeping ones the update skips
+	std::vector<float> m_lRestPositionX; //x of the position of each body at the end of the last update
+	std::vector<float> m_lRestPositionY; //y of the position of each body at the end of the last update
+	std::vector<float> m_lRestPositionZ; //z of the position of each body at the end of the last update
+	std::vector<float> m_lPushX; //x of the push the contacts gave to each body on this update
+	std::vector<float> m_lPushY; //y of the push the contacts gave to each body on this update
+	std::vector<float> m_lPushZ; //z of the push the contacts gave to each body on this update
+	std::vector<float> m_lSubstepX; //x of the position of each body at the start of the substep
+	std::vector<float> m_lSubstepY; //y of the position of each body at the start of the substep
+	std::vector<float> m_lSubstepZ; //z of the position of each body at the start of the substep
+	std::vector<std::vector<float>*> m_lFloatArray; //all the arrays of floats above, listed once
+	std::vector<bool> m_lContinuous; //checks what the body went through in the last update when it moves fast
+	std::vector<matrix4> m_lModelMatrix; //translation and scale of each body, written by the update
+
+	std::vector<uint> m_lFreeList; //indices of removed bodies, given again to the next added ones
+	uint m_uBodyCount = 0; //number of bodies in use
+
+	bool m_bSleeping = true; //bodies that stay still long enough are put to sleep
+	float m_fSleepDistance = 0.05f; //moving less than this from one update to the next the body counts as still
+	uint m_uSleepSteps = 30; //updates in a row every body of an island needs to be still for it to sleep
+	std::vector<uint> m_lStillSteps; //updates in a row each body has been still
+	std::vector<uint> m_lSleepingIsland; //sleeping island of each body, -1 while awake
+	std::map<uint, std::vector<uint>> m_mSleepingIslandMap; //bodies of each sleeping island
+	uint m_uNextIsland = 0; //name of the next island that goes to sleep
+	uint m_uSleepingCount = 0; //number of sleeping bodies
+	uint m_uIslandCount = 0; //number of awake islands found in the last update
+	std::vector<Contact> m_lContactList; //contacts found since the last update
+	std::map<std::pair<uint, uint>, vector3> m_mImpulseMap; //impulse each pair ended the last update with, smaller body first
+	std::vector<uint> m_lIsland; //island each awake body is joined to while the islands are found
+	std::vector<uint> m_lIslandSteps; //updates the least still body of each island has been still
+
+	bool m_bThreads = true; //solves the islands on the thread pool
+	bool m_bDeterministic = false; //sorts the contacts before solving them
+	uint m_uColourSize = 256; //islands with this many contacts are split by colour between the threads
+	uint m_uBatchSize = 64; //contacts given to a thread at once
+	std::vector<SolverIsland> m_lSolverIslandList; //islands of the contacts of this update
+	std::vector<uint> m_lIslandIndex; //island of the solver list each body that names an island has
+	std::vector<uint> m_lContactIsland; //island of the solver list of each contact, -1 when it has none
+	std::vector<uint> m_lIslandContact; //contacts ordered by island, and by colour in the big islands
+	std::vector<uint> m_lColourStart; //where each colour of the big islands starts, then where the island ends
+	std::vector<uint> m_lContactColour; //colour of each contact of the island being coloured
+	std::vector<uint> m_lColourMask; //colours each body already has in the island being coloured
+
+	float m_fGravity = -0.035f; //acceleration pulling down the bodies of mass 1 on each update
+	float m_fMaxVelocity = 5.0f; //fastest a body can move
+	float m_fFriction = 0.1f; //part of the velocity lost on each update
+	float m_fMinVelocity = 0.028f; //slower than this the body stops
+
+	eSolverMode m_nSolverMode = SOLVER_IMPULSE; //how the contacts are solved
+	uint m_uIterations = 10; //passes of the solver over all the contacts
+	uint m_uSubsteps = 8; //substeps of the position solver on each update
+	float m_fCompliance = 0.0f; //softness of the contacts of the position solver, 0 is rigid
+	float m_fSurfaceFriction = 0.5f; //friction impulse the contacts can hold for each unit of normal impulse
+	float m_fRestitution = 0.1f; //part of the approach velocity the bodies bounce back with
+	float m_fBounceVelocity = 0.1f; //approaching slower than this the bodies do not bounce
+	float m_fSlop = 0.01f; //overlap the contacts leave alone so they stay in touch
+	float m_fPushFactor = 0.2f; //part of the overlap the contacts take out on each update
+
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyPhysicsWorld* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a body at the origin, with no velocity, size and mass of 1 and not simulated
+	ARGUMENTS: ---
+	OUTPUT: index of the body
+	*/
+	uint AddBody(void);
+	/*
+	USAGE: Removes the body, its index will be given to a body added later
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void RemoveBody(uint a_uBody);
+	/*
+	USAGE: Copies the state of one body into other
+	ARGUMENTS:
+	-	uint a_uSource -> index of the body to copy
+	-	uint a_uTarget -> index of the body to copy into
+	OUTPUT: ---
+	*/
+	void CopyBody(uint a_uSource, uint a_uTarget);
+	/*
+	USAGE: Makes room for the bodies so adding them does not grow the arrays one at a time
+	ARGUMENTS: uint a_uCount -> number of bodies expected
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCount);
+	/*
+	USAGE: Gets the number of bodies in use
+	ARGUMENTS: ---
+	OUTPUT: body count
+	*/
+	uint GetBodyCount(void);
+
+	/*
+	USAGE: Sets the position of the body
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	vector3 a_v3Position -> position to set
+	OUTPUT: ---
+	*/
+	void SetPosition(uint a_uBody, vector3 a_v3Position);
+	/*
+	USAGE: Gets the position of the body
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: position of the body
+	*/
+	vector3 GetPosition(uint a_uBody);
+	/*
+	USAGE: Sets the position of the body before the last update
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	vector3 a_v3Position -> last position to set
+	OUTPUT: ---
+	*/
+	void SetLastPosition(uint a_uBody, vector3 a_v3Position);
+	/*
+	USAGE: Gets the position of the body before the last update
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: last position of the body
+	*/
+	vector3 GetLastPosition(uint a_uBody);
+	/*
+	USAGE: Sets the size of the body
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	vector3 a_v3Size -> size to set
+	OUTPUT: ---
+	*/
+	void SetSize(uint a_uBody, vector3 a_v3Size);
+	/*
+	USAGE: Gets the size of the body
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: size of the body
+	*/
+	vector3 GetSize(uint a_uBody);
+	/*
+	USAGE: Sets the velocity of the body
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	vector3 a_v3Velocity -> velocity to set
+	OUTPUT: ---
+	*/
+	void SetVelocity(uint a_uBody, vector3 a_v3Velocity);
+	/*
+	USAGE: Gets the velocity of the body
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: velocity of the body
+	*/
+	vector3 GetVelocity(uint a_uBody);
+	/*
+	USAGE: Sets the acceleration of the body, it is cleared after each update
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	vector3 a_v3Acceleration -> acceleration to set
+	OUTPUT: ---
+	*/
+	void SetAcceleration(uint a_uBody, vector3 a_v3Acceleration);
+	/*
+	USAGE: Gets the acceleration of the body
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: acceleration of the body
+	*/
+	vector3 GetAcceleration(uint a_uBody);
+	/*
+	USAGE: Sets the mass of the body
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	float a_fMass -> mass to set
+	OUTPUT: ---
+	*/
+	void SetMass(uint a_uBody, float a_fMass);
+	/*
+	USAGE: Gets the mass of the body
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: mass of the body
+	*/
+	float GetMass(uint a_uBody);
+	/*
+	USAGE: Sets if the update moves the body
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	bool a_bSimulated -> is it moved by the update?
+	OUTPUT: ---
+	*/
+	void SetSimulated(uint a_uBody, bool a_bSimulated);
+	/*
+	USAGE: Gets if the update moves the body
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: is it moved by the update?
+	*/
+	bool GetSimulated(uint a_uBody);
+	/*
+	USAGE: Sets if the body checks for collisions along the way when it moves fast
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	bool a_bContinuous -> check along the way?
+	OUTPUT: ---
+	*/
+	void SetContinuous(uint a_uBody, bool a_bContinuous);
+	/*
+	USAGE: Gets if the body checks for collisions along the way when it moves fast
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: check along the way?
+	*/
+	bool GetContinuous(uint a_uBody);
+	/*
+	USAGE: Asks if the body is awake, sleeping bodies are neither moved by the update nor tested against
+	other sleeping bodies
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: is it awake?
+	*/
+	bool IsAwake(uint a_uBody);
+	/*
+	USAGE: Wakes the body and all the bodies of the island it fell asleep with, and starts counting
+	its still updates again
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void WakeBody(uint a_uBody);
+	/*
+	USAGE: Tells the world two bodies are in contact, the contacts are solved all together on the next
+	update and the bodies joined by them form an island that sleeps and wakes as a whole
+	ARGUMENTS:
+	-	uint a_uBody -> index of one body
+	-	uint a_uOther -> index of the other body
+	-	vector3 a_v3Normal -> direction from the body to the other
+	-	float a_fDepth -> how much they go into each other
+	OUTPUT: ---
+	*/
+	void AddContact(uint a_uBody, uint a_uOther, vector3 a_v3Normal, float a_fDepth);
+	/*
+	USAGE: Sets the number of passes the solver makes over the contacts, more passes settle stacks better
+	ARGUMENTS: uint a_uIterations -> passes
+	OUTPUT: ---
+	*/
+	void SetSolverIterations(uint a_uIterations);
+	/*
+	USAGE: Gets the number of passes the solver makes over the contacts
+	ARGUMENTS: ---
+	OUTPUT: passes
+	*/
+	uint GetSolverIterations(void);
+	/*
+	USAGE: Sets how the contacts are solved, impulses on the velocities or positions projected over substeps
+	ARGUMENTS: eSolverMode a_nMode -> solver
+	OUTPUT: ---
+	*/
+	void SetSolverMode(eSolverMode a_nMode);
+	/*
+	USAGE: Gets how the contacts are solved
+	ARGUMENTS: ---
+	OUTPUT: solver
+	*/
+	eSolverMode GetSolverMode(void);
+	/*
+	USAGE: Sets the number of substeps the position solver splits each update in
+	ARGUMENTS: uint a_uSubsteps -> substeps, at least 1
+	OUTPUT: ---
+	*/
+	void SetSubsteps(uint a_uSubsteps);
+	/*
+	USAGE: Gets the number of substeps the position solver splits each update in
+	ARGUMENTS: ---
+	OUTPUT: substeps
+	*/
+	uint GetSubsteps(void);
+	/*
+	USAGE: Sets if the islands are solved on the thread pool, the result is the same either way
+	ARGUMENTS: bool a_bUse = true -> use the threads?
+	OUTPUT: ---
+	*/
+	void UseThreads(bool a_bUse = true);
+	/*
+	USAGE: Gets the inverse mass of the body when pushed in a direction, with the impulse solver the floor
+	holds the bodies on it; the bodies the world does not move cannot be pushed
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	vector3 a_v3Push -> direction of the push
+	OUTPUT: inverse mass, 0 when it cannot move
+	*/
+	float GetInverseMass(uint a_uBody, vector3 a_v3Push);
+	/*
+	USAGE: Sets if the bodies that stay still are put to sleep, turning it off wakes all of them
+	ARGUMENTS: bool a_bUse = true -> put them to sleep?
+	OUTPUT: ---
+	*/
+	void UseSleeping(bool a_bUse = true);
+	/*
+	USAGE: Sets when a body is still and for how long the island needs to be still to sleep
+	ARGUMENTS:
+	-	float a_fDistance -> moving less than this from one update to the next, contacts included,
+	the body counts as still
+	-	uint a_uSteps -> updates in a row every body of an island needs to be still
+	OUTPUT: ---
+	*/
+	void SetSleepThreshold(float a_fDistance, uint a_uSteps);
+	/*
+	USAGE: Gets the number of sleeping bodies
+	ARGUMENTS: ---
+	OUTPUT: sleeping count
+	*/
+	uint GetSleepingCount(void);
+	/*
+	USAGE: Gets the number of islands of awake bodies found in the last update
+	ARGUMENTS: ---
+	OUTPUT: island count
+	*/
+	uint GetIslandCount(void);
+	/*
+	USAGE: Sets if the contacts are sorted by their bodies before they are solved, so the same state gives
+	the same result whatever order the entity manager found them in
+	ARGUMENTS: bool a_bUse = true -> sort them?
+	OUTPUT: ---
+	*/
+	void UseDeterministicOrder(bool a_bUse = true);
+	/*
+	USAGE: Saves the state of all the bodies and the impulses of the pairs in contact into a buffer, each
+	array is copied as a block
+	ARGUMENTS: std::vector<char>& a_lBuffer -> buffer to write, its contents are replaced
+	OUTPUT: ---
+	*/
+	void SaveSnapshot(std::vector<char>& a_lBuffer);
+	/*
+	USAGE: Loads the state saved by SaveSnapshot, the world needs to have the same bodies it had then;
+	the contacts added since the last update are dropped
+	ARGUMENTS: std::vector<char> const& a_lBuffer -> buffer to read
+	OUTPUT: was it loaded?
+	*/
+	bool LoadSnapshot(std::vector<char> const& a_lBuffer);
+	/*
+	USAGE: Gets the model matrix of the body written by the last update, translation times scale
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: model matrix of the body
+	*/
+	matrix4 GetModelMatrix(uint a_uBody);
+
+	/*
+	USAGE: Integrates the velocity of all the simulated bodies that are awake, pulling them down, limiting,
+	slowing and stopping it, solves the contacts added since the last update, moves the bodies keeping them
+	above the floor, puts to sleep the islands that stayed still and writes the model matrices of all of
+	them; four bodies are integrated at a time when the processor allows it. The position solver moves the
+	bodies in substeps instead, projecting them out of each other and the ground on each one
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Update(void);
+	/*
+	USAGE: Integrates a single body the same way the update does, simulated or not, without contacts
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void UpdateBody(uint a_uBody);
+
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyPhysicsWorld(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyPhysicsWorld(MyPhysicsWorld const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyPhysicsWorld& operator=(MyPhysicsWorld const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyPhysicsWorld(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Sets the body to the state of a newly added one
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void ResetBody(uint a_uBody);
+	/*
+	USAGE: Gets all the arrays of floats, to go through them when the bodies are added, copied or released
+	ARGUMENTS: ---
+	OUTPUT: pointers to the arrays, the list is made once with the world
+	*/
+	std::vector<std::vector<float>*> const& GetFloatArrays(void);
+	/*
+	USAGE: Writes the model matrices of all the bodies from their position and size
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateModelMatrices(void);
+	/*
+	USAGE: Puts the smaller body of each contact first and sorts the contacts by their bodies
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SortContacts(void);
+	/*
+	USAGE: Finds the island the body is joined to, shortening the path on the way
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: body that names the island
+	*/
+	uint FindIsland(uint a_uBody);
+	/*
+	USAGE: Joins the awake bodies in contact into islands and puts to sleep the islands whose bodies
+	have all been still for long enough
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateIslands(void);
+	/*
+	USAGE: Adds the forces and gravity to the velocity of the body, limits, slows and stops it
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void IntegrateVelocity(uint a_uBody);
+	/*
+	USAGE: Moves the body by its velocity and the push of the contacts, keeping it above the floor
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void IntegratePosition(uint a_uBody);
+	/*
+	USAGE: Integrates the velocity of all the simulated bodies that are awake
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegrateVelocities(void);
+	/*
+	USAGE: Moves all the simulated bodies that are awake
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegratePositions(void);
+	/*
+	USAGE: Sets the inverse masses, friction directions and bounce of the contact and applies the impulse
+	the pair ended the last update with
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void PrepareContact(Contact& a_Contact);
+	/*
+	USAGE: One pass of the solver on the velocity of a contact, the friction is clamped to what the
+	normal impulse holds and the normal impulse to only push
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void SolveVelocity(Contact& a_Contact);
+	/*
+	USAGE: One pass of the solver on the push taking the bodies of a contact out of each other
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void SolvePush(Contact& a_Contact);
+	/*
+	USAGE: Joins the bodies the world moves into islands by their contacts, groups the contacts by
+	island and colours the big islands
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void BuildIslands(void);
+	/*
+	USAGE: Orders the contacts of an island by colour, two contacts of a colour never write the same body
+	ARGUMENTS: SolverIsland& a_Island -> island
+	OUTPUT: ---
+	*/
+	void ColourIsland(SolverIsland& a_Island);
+	/*
+	USAGE: Does a step to a range of the island contact list, in order
+	ARGUMENTS:
+	-	uint a_uFirst -> first of the range
+	-	uint a_uEnd -> one after the last of the range
+	-	ContactStep a_pStep -> step to do
+	OUTPUT: ---
+	*/
+	void SolveRange(uint a_uFirst, uint a_uEnd, ContactStep a_pStep);
+	/*
+	USAGE: Does a step to the contacts of the small islands in a range of the solver island list, the big
+	ones are skipped
+	ARGUMENTS:
+	-	uint a_uFirst -> first island of the range
+	-	uint a_uEnd -> one after the last island of the range
+	-	ContactStep a_pStep -> step to do
+	OUTPUT: ---
+	*/
+	void SolveBatch(uint a_uFirst, uint a_uEnd, ContactStep a_pStep);
+	/*
+	USAGE: Does a step to all the contacts of a big island, one colour after the other, splitting each
+	colour between the threads
+	ARGUMENTS:
+	-	SolverIsland const& a_Island -> island
+	-	ContactStep a_pStep -> step to do
+	OUTPUT: ---
+	*/
+	void SolveColours(SolverIsland const& a_Island, ContactStep a_pStep);
+	/*
+	USAGE: Does a step to the contacts of all the islands, the small ones in batches on the thread pool
+	and the big ones colour by colour, and waits for all of them
+	ARGUMENTS: ContactStep a_pStep -> step to do
+	OUTPUT: ---
+	*/
+	void SolveIslands(ContactStep a_pStep);
+	/*
+	USAGE: Sets the inverse masses of the contact for the position solver
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void PrepareProjection(Contact& a_Contact);
+	/*
+	USAGE: Moves the two bodies of a contact by a correction, the other body gets it and the body gets
+	it reversed
+	ARGUMENTS:
+	-	Contact const& a_Contact -> contact
+	-	vector3 a_v3Correction -> correction, times the inverse mass of each body
+	OUTPUT: ---
+	*/
+	void ApplyCorrection(Contact const& a_Contact, vector3 a_v3Correction);
+	/*
+	USAGE: Gets the depth of a contact from the one measured at the start of the update and what its
+	bodies moved since
+	ARGUMENTS: Contact const& a_Contact -> contact
+	OUTPUT: depth, negative when they are apart
+	*/
+	float GetProjectedDepth(Contact const& a_Contact);
+	/*
+	USAGE: Takes the bodies of a contact out of each other before the substeps, so it gives them no velocity
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void Prestabilize(Contact& a_Contact);
+	/*
+	USAGE: Keeps the overlap of a contact the prestabilization left, the substeps do not take it out
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void KeepDepth(Contact& a_Contact);
+	/*
+	USAGE: Projects the bodies of a contact out of what they went deeper than its kept overlap, and takes back
+	what they slid along each other in the substep as much as the friction allows
+	ARGUMENTS: Contact& a_Contact -> contact
+	OUTPUT: ---
+	*/
+	void ProjectContact(Contact& a_Contact);
+	/*
+	USAGE: Keeps where the body starts the substep, pulls it down and moves it by its velocity
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	float a_fStep -> length of the substep, in updates
+	OUTPUT: ---
+	*/
+	void PredictPosition(uint a_uBody, float a_fStep);
+	/*
+	USAGE: Projects the body out of the ground, with friction on what it slid along it
+	ARGUMENTS: uint a_uBody -> index of the body
+	OUTPUT: ---
+	*/
+	void ProjectGround(uint a_uBody);
+	/*
+	USAGE: Sets the velocity of the body to what it moved in the substep
+	ARGUMENTS:
+	-	uint a_uBody -> index of the body
+	-	float a_fStep -> length of the substep, in updates
+	OUTPUT: ---
+	*/
+	void DeriveVelocity(uint a_uBody, float a_fStep);
+	/*
+	USAGE: The position solver, moves all the simulated bodies that are awake in substeps projecting them
+	out of each other and the ground on each one
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ProjectContacts(void);
+	/*
+	USAGE: Changes the velocity of the two bodies of a contact by an impulse, the other body gets
+	it and the body gets it reversed
+	ARGUMENTS:
+	-	Contact const& a_Contact -> contact
+	-	vector3 a_v3Impulse -> impulse
+	OUTPUT: ---
+	*/
+	void ApplyImpulse(Contact const& a_Contact, vector3 a_v3Impulse);
+	/*
+	USAGE: Solves all the contacts together, starting from the impulses the same pairs ended the last
+	update with; each pass clamps the friction to what the normal impulse holds and the normal impulse
+	to only push, then the overlap is taken out by a push that adds no velocity. The islands are solved
+	at the same time on the thread pool and the big ones are split by colour
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SolveContacts(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYPHYSICSWORLD_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -26,6 +26,13 @@ void MyRigidBody::Init(void)
 
 	m_m4ToWorld = IDENTITY_M4;
 
+	m_v3AxisG[0] = AXIS_X;
+	m_v3AxisG[1] = AXIS_Y;
+	m_v3AxisG[2] = AXIS_Z;
+	m_v3HalfWidthG = ZERO_V3;
+
+	m_pHull = nullptr;
+
 	m_uCollidingCount = 0;
 	m_CollidingArray = nullptr;
 }
@@ -54,6 +61,12 @@ void MyRigidBody::Swap(MyRigidBody& other)
 
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
 
+	for (uint i = 0; i < 3; ++i)
+		std::swap(m_v3AxisG[i], other.m_v3AxisG[i]);
+	std::swap(m_v3HalfWidthG, other.m_v3HalfWidthG);
+
+	std::swap(m_pHull, other.m_pHull);
+
 	std::swap(m_uCollidingCount, other.m_uCollidingCount);
 	std::swap(m_CollidingArray, other.m_CollidingArray);
 }
@@ -81,6 +94,10 @@ vector3 MyRigidBody::GetCenterGlobal(void){ return m_v3CenterG; }
 vector3 MyRigidBody::GetMinGlobal(void) { return m_v3MinG; }
 vector3 MyRigidBody::GetMaxGlobal(void) { return m_v3MaxG; }
 vector3 MyRigidBody::GetHalfWidth(void) { return m_v3HalfWidth; }
+vector3 MyRigidBody::GetHalfWidthGlobal(void) { return m_v3HalfWidthG; }
+vector3 MyRigidBody::GetAxisGlobal(uint a_uAxis) { return m_v3AxisG[a_uAxis]; }
+MyConvexHull* MyRigidBody::GetConvexHull(void) { return m_pHull; }
+void MyRigidBody::SetConvexHull(MyConvexHull* a_pHull) { m_pHull = a_pHull; }
 matrix4 MyRigidBody::GetModelMatrix(void) { return m_m4ToWorld; }
 MyRigidBody::PRigidBody* MyRigidBody::GetColliderArray(void) { return m_CollidingArray; }
 uint MyRigidBody::GetCollidingCount(void) { return m_uCollidingCount; }
@@ -94,6 +111,7 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 	m_m4ToWorld = a_m4ModelMatrix;
 
 	m_v3CenterG = vector3(m_m4ToWorld * vector4(m_v3CenterL, 1.0f));
+	UpdateGlobalOBB();
 
 	//Calculate the 8 corners of the cube
 	vector3 v3Corner[8];
@@ -134,6 +152,20 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 	//we calculate the distance between min and max vectors
 	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 }
+void MyRigidBody::UpdateGlobalOBB(void)
+{
+	//the columns of the model matrix are the axes, their length is the scale along them
+	for (uint i = 0; i < 3; ++i)
+	{
+		vector3 v3Column = vector3(m_m4ToWorld[i]);
+		float fScale = glm::length(v3Column);
+		if (fScale > 0.0f)
+			m_v3AxisG[i] = v3Column / fScale;
+		else
+			m_v3AxisG[i] = vector3(IDENTITY_M4[i]);
+		m_v3HalfWidthG[i] = m_v3HalfWidth[i] * fScale;
+	}
+}
 //The big 3
 MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 {
@@ -173,6 +205,9 @@ MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 
 	//Get the distance between the center and either the min or the max
 	m_fRadius = glm::distance(m_v3CenterL, m_v3MinL);
+
+	m_v3CenterG = m_v3CenterL;
+	UpdateGlobalOBB();
 }
 MyRigidBody::MyRigidBody(MyRigidBody const& other)
 {
@@ -200,6 +235,12 @@ MyRigidBody::MyRigidBody(MyRigidBody const& other)
 
 	m_m4ToWorld = other.m_m4ToWorld;
 
+	for (uint i = 0; i < 3; ++i)
+		m_v3AxisG[i] = other.m_v3AxisG[i];
+	m_v3HalfWidthG = other.m_v3HalfWidthG;
+
+	m_pHull = other.m_pHull;
+
 	m_uCollidingCount = other.m_uCollidingCount;
 	m_CollidingArray = other.m_CollidingArray;
 }
@@ -326,7 +367,688 @@ bool MyRigidBody::IsColliding(MyRigidBody* const other)
 	}
 	return bColliding;
 }
+bool MyRigidBody::GetManifold(MyRigidBody* const a_pOther, MyManifold& a_Manifold)
+{
+	vector3 const* v3AxisA = m_v3AxisG;
+	vector3 const* v3AxisB = a_pOther->m_v3AxisG;
+	vector3 v3HalfA = m_v3HalfWidthG;
+	vector3 v3HalfB = a_pOther->m_v3HalfWidthG;
+	vector3 v3Distance = a_pOther->m_v3CenterG - m_v3CenterG;
+
+	//rotation of the other box in the frame of this one, with an epsilon for nearly parallel edges
+	float fRotation[3][3];
+	float fAbsRotation[3][3];
+	bool bParallel = false;
+	for (uint i = 0; i < 3; i++)
+	{
+		for (uint j = 0; j < 3; j++)
+		{
+			fRotation[i][j] = glm::dot(v3AxisA[i], v3AxisB[j]);
+			fAbsRotation[i][j] = glm::abs(fRotation[i][j]) + FLT_EPSILON;
+			if (fAbsRotation[i][j] > 1.0f - 0.00001f)
+				bParallel = true;
+		}
+	}
+
+	//distance between the centers in the frame of this box
+	vector3 v3T(glm::dot(v3Distance, v3AxisA[0]), glm::dot(v3Distance, v3AxisA[1]), glm::dot(v3Distance, v3AxisA[2]));
+
+	//the axis where the boxes go into each other the least is the contact normal
+	float fBestDepth = FLT_MAX;
+	vector3 v3BestNormal = AXIS_Y;
+	uint uBestAxis = eSATResults::SAT_NONE;
+
+	//faces of this box
+	for (uint i = 0; i < 3; i++)
+	{
+		float fRadiusB = v3HalfB[0] * fAbsRotation[i][0] + v3HalfB[1] * fAbsRotation[i][1] + v3HalfB[2] * fAbsRotation[i][2];
+		float fDepth = v3HalfA[i] + fRadiusB - glm::abs(v3T[i]);
+		if (fDepth < 0.0f)
+			return false;
+		if (fDepth < fBestDepth)
+		{
+			fBestDepth = fDepth;
+			v3BestNormal = v3T[i] < 0.0f ? -v3AxisA[i] : v3AxisA[i];
+			uBestAxis = eSATResults::SAT_AX + i;
+		}
+	}
+
+	//faces of the other box, they need to be a bit better to win so the same face is picked every frame
+	for (uint j = 0; j < 3; j++)
+	{
+		float fRadiusA = v3HalfA[0] * fAbsRotation[0][j] + v3HalfA[1] * fAbsRotation[1][j] + v3HalfA[2] * fAbsRotation[2][j];
+		float fProjection = v3T[0] * fRotation[0][j] + v3T[1] * fRotation[1][j] + v3T[2] * fRotation[2][j];
+		float fDepth = fRadiusA + v3HalfB[j] - glm::abs(fProjection);
+		if (fDepth < 0.0f)
+			return false;
+		if (fDepth < fBestDepth * 0.95f)
+		{
+			fBestDepth = fDepth;
+			v3BestNormal = fProjection < 0.0f ? -v3AxisB[j] : v3AxisB[j];
+			uBestAxis = eSATResults::SAT_BX + j;
+		}
+	}
+
+	//edges, when two axes are parallel their cross products are degenerate and the faces are enough
+	uint uEdgeA = 0;
+	uint uEdgeB = 0;
+	if (!bParallel)
+	{
+		for (uint i = 0; i < 3; i++)
+		{
+			uint i1 = (i + 1) % 3;
+			uint i2 = (i + 2) % 3;
+			for (uint j = 0; j < 3; j++)
+			{
+				uint j1 = (j + 1) % 3;
+				uint j2 = (j + 2) % 3;
+				vector3 v3Axis = glm::cross(v3AxisA[i], v3AxisB[j]);
+				float fLength = glm::length(v3Axis);
+				if (fLength < 0.00001f)
+					continue;
+
+				float fRadiusA = v3HalfA[i1] * fAbsRotation[i2][j] + v3HalfA[i2] * fAbsRotation[i1][j];
+				float fRadiusB = v3HalfB[j1] * fAbsRotation[i][j2] + v3HalfB[j2] * fAbsRotation[i][j1];
+				float fProjection = v3T[i2] * fRotation[i1][j] - v3T[i1] * fRotation[i2][j];
+				float fDepth = (fRadiusA + fRadiusB - glm::abs(fProjection)) / fLength;
+				if (fDepth < 0.0f)
+					return false;
+				if (fDepth < fBestDepth * 0.95f)
+				{
+					fBestDepth = fDepth;
+					v3BestNormal = (fProjection < 0.0f ? -v3Axis : v3Axis) / fLength;
+					uBestAxis = eSATResults::SAT_AXxBX + i * 3 + j;
+					uEdgeA = i;
+					uEdgeB = j;
+				}
+			}
+		}
+	}
+
+	//the boxes overlap, with a hull the shapes inside them may still not
+	if (m_pHull != nullptr || a_pOther->m_pHull != nullptr)
+		return GetHullManifold(a_pOther, a_Manifold);
+
+	a_Manifold.m_v3Normal = v3BestNormal;
+	a_Manifold.m_fDepth = fBestDepth;
+	a_Manifold.m_uAxis = uBestAxis;
+	a_Manifold.m_uPointCount = 0;
+
+	if (uBestAxis < eSATResults::SAT_BX)
+	{
+		ClipFace(this, a_pOther, v3BestNormal, uBestAxis - eSATResults::SAT_AX, a_Manifold);
+	}
+	else if (uBestAxis < eSATResults::SAT_AXxBX)
+	{
+		ClipFace(a_pOther, this, -v3BestNormal, uBestAxis - eSATResults::SAT_BX, a_Manifold);
+	}
+	else
+	{
+		//the edge of each box that is the furthest along the normal towards the other box
+		vector3 v3PointA = m_v3CenterG;
+		vector3 v3PointB = a_pOther->m_v3CenterG;
+		for (uint k = 0; k < 3; k++)
+		{
+			if (k != uEdgeA)
+				v3PointA += v3AxisA[k] * (glm::dot(v3AxisA[k], v3BestNormal) < 0.0f ? -v3HalfA[k] : v3HalfA[k]);
+			if (k != uEdgeB)
+				v3PointB += v3AxisB[k] * (glm::dot(v3AxisB[k], v3BestNormal) > 0.0f ? -v3HalfB[k] : v3HalfB[k]);
+		}
+
+		//closest points of the two edges
+		vector3 v3DirA = v3AxisA[uEdgeA];
+		vector3 v3DirB = v3AxisB[uEdgeB];
+		vector3 v3Offset = v3PointA - v3PointB;
+		float fDot = glm::dot(v3DirA, v3DirB);
+		float fDenominator = 1.0f - fDot * fDot;
+		float fA = 0.0f;
+		float fB = 0.0f;
+		if (fDenominator > 0.00001f)
+		{
+			float fOffsetA = glm::dot(v3DirA, v3Offset);
+			float fOffsetB = glm::dot(v3DirB, v3Offset);
+			fA = glm::clamp((fDot * fOffsetB - fOffsetA) / fDenominator, -v3HalfA[uEdgeA], v3HalfA[uEdgeA]);
+			fB = glm::clamp(fOffsetB + fDot * fA, -v3HalfB[uEdgeB], v3HalfB[uEdgeB]);
+			//if the other edge got clamped the closest point on this one moves with it
+			fA = glm::clamp(fDot * fB - fOffsetA, -v3HalfA[uEdgeA], v3HalfA[uEdgeA]);
+		}
+
+		a_Manifold.m_v3Point[0] = ((v3PointA + v3DirA * fA) + (v3PointB + v3DirB * fB)) * 0.5f;
+		a_Manifold.m_fPointDepth[0] = fBestDepth;
+		a_Manifold.m_uPointCount = 1;
+	}
+
+	return true;
+}
+bool MyRigidBody::SweepARBB(MyRigidBody* const a_pOther, vector3 a_v3Displacement, float& a_fTime, vector3& a_v3Normal)
+{
+	//boxes at the start of the step, seen from the other body that stays still
+	vector3 v3Min = m_v3MinG - a_v3Displacement;
+	vector3 v3Max = m_v3MaxG - a_v3Displacement;
+	vector3 v3OtherMin = a_pOther->m_v3MinG;
+	vector3 v3OtherMax = a_pOther->m_v3MaxG;
+
+	//when the box gets in and out of the slab of the other one along each axis, it is touching
+	//while it is inside the three of them
+	float fEnter = -FLT_MAX;
+	float fExit = FLT_MAX;
+	uint uAxis = 0;
+	for (uint i = 0; i < 3; ++i)
+	{
+		if (a_v3Displacement[i] == 0.0f)
+		{
+			if (v3Max[i] < v3OtherMin[i] || v3Min[i] > v3OtherMax[i])
+				return false;
+			continue;
+		}
+		float fNear = (v3OtherMin[i] - v3Max[i]) / a_v3Displacement[i];
+		float fFar = (v3OtherMax[i] - v3Min[i]) / a_v3Displacement[i];
+		if (fNear > fFar)
+			std::swap(fNear, fFar);
+		if (fNear > fEnter)
+		{
+			fEnter = fNear;
+			uAxis = i;
+		}
+		fExit = glm::min(fExit, fFar);
+	}
+
+	//already overlapping at the start is for the narrowphase, not touching within the step is no hit
+	if (fEnter > fExit || fEnter < 0.0f || fEnter > 1.0f)
+		return false;
+
+	a_fTime = fEnter;
+	a_v3Normal = ZERO_V3;
+	a_v3Normal[uAxis] = a_v3Displacement[uAxis] > 0.0f ? 1.0f : -1.0f;
+	return true;
+}
+void MyRigidBody::ClipFace(MyRigidBody* const a_pReference, MyRigidBody* const a_pIncident, vector3 a_v3Normal,
+	uint a_uAxis, MyManifold& a_Manifold)
+{
+	vector3 const* v3AxisR = a_pReference->m_v3AxisG;
+	vector3 const* v3AxisI = a_pIncident->m_v3AxisG;
+	vector3 v3HalfR = a_pReference->m_v3HalfWidthG;
+	vector3 v3HalfI = a_pIncident->m_v3HalfWidthG;
 
+	//the face of the incident box that faces the reference face the most
+	uint uFace = 0;
+	float fBest = -1.0f;
+	for (uint k = 0; k < 3; k++)
+	{
+		float fFacing = glm::abs(glm::dot(v3AxisI[k], a_v3Normal));
+		if (fFacing > fBest)
+		{
+			fBest = fFacing;
+			uFace = k;
+		}
+	}
+	vector3 v3FaceNormal = glm::dot(v3AxisI[uFace], a_v3Normal) > 0.0f ? -v3AxisI[uFace] : v3AxisI[uFace];
+	vector3 v3FaceCenter = a_pIncident->m_v3CenterG + v3FaceNormal * v3HalfI[uFace];
+	uint uU = (uFace + 1) % 3;
+	uint uV = (uFace + 2) % 3;
+	vector3 v3U = v3AxisI[uU] * v3HalfI[uU];
+	vector3 v3V = v3AxisI[uV] * v3HalfI[uV];
+
+	//polygon being clipped, a quad can become an octagon at most
+	vector3 v3Polygon[8];
+	vector3 v3Clipped[8];
+	uint uCount = 4;
+	v3Polygon[0] = v3FaceCenter + v3U + v3V;
+	v3Polygon[1] = v3FaceCenter - v3U + v3V;
+	v3Polygon[2] = v3FaceCenter - v3U - v3V;
+	v3Polygon[3] = v3FaceCenter + v3U - v3V;
+
+	//clip it against the four sides of the reference face
+	vector3 v3RefCenter = a_pReference->m_v3CenterG;
+	for (uint uSide = 0; uSide < 4 && uCount > 0; uSide++)
+	{
+		uint uSideAxis = (a_uAxis + 1 + uSide / 2) % 3;
+		vector3 v3SideNormal = (uSide % 2 == 0) ? v3AxisR[uSideAxis] : -v3AxisR[uSideAxis];
+		float fOffset = glm::dot(v3RefCenter, v3SideNormal) + v3HalfR[uSideAxis];
+
+		uint uClipped = 0;
+		for (uint i = 0; i < uCount; i++)
+		{
+			vector3 v3Start = v3Polygon[i];
+			vector3 v3End = v3Polygon[(i + 1) % uCount];
+			float fStart = glm::dot(v3Start, v3SideNormal) - fOffset;
+			float fEnd = glm::dot(v3End, v3SideNormal) - fOffset;
+			if (fStart <= 0.0f)
+				v3Clipped[uClipped++] = v3Start;
+			//a point right on the side is kept as it is, the edge only crosses if the signs are opposite
+			if ((fStart < 0.0f && fEnd > 0.0f) || (fStart > 0.0f && fEnd < 0.0f))
+				v3Clipped[uClipped++] = v3Start + (v3End - v3Start) * (fStart / (fStart - fEnd));
+		}
+		for (uint i = 0; i < uClipped; i++)
+			v3Polygon[i] = v3Clipped[i];
+		uCount = uClipped;
+	}
+
+	//keep the points below the reference face
+	float fFaceOffset = glm::dot(v3RefCenter, a_v3Normal) + v3HalfR[a_uAxis];
+	vector3 v3Point[8];
+	float fDepth[8];
+	uint uPoints = 0;
+	for (uint i = 0; i < uCount; i++)
+	{
+		float fSeparation = glm::dot(v3Polygon[i], a_v3Normal) - fFaceOffset;
+		if (fSeparation <= 0.0f)
+		{
+			v3Point[uPoints] = v3Polygon[i] - a_v3Normal * (fSeparation * 0.5f);
+			fDepth[uPoints] = -fSeparation;
+			++uPoints;
+		}
+	}
+
+	//nothing left after clipping (rounding), use the deepest corner of the incident box
+	if (uPoints == 0)
+	{
+		vector3 v3Corner = a_pIncident->m_v3CenterG;
+		for (uint k = 0; k < 3; k++)
+			v3Corner += v3AxisI[k] * (glm::dot(v3AxisI[k], a_v3Normal) > 0.0f ? -v3HalfI[k] : v3HalfI[k]);
+		a_Manifold.m_v3Point[0] = v3Corner + a_v3Normal * (a_Manifold.m_fDepth * 0.5f);
+		a_Manifold.m_fPointDepth[0] = a_Manifold.m_fDepth;
+		a_Manifold.m_uPointCount = 1;
+		return;
+	}
+
+	//with more than 4 keep the deepest, the furthest from it and the two that make the biggest area on each side
+	uint uKeep[4] = { 0, 0, 0, 0 };
+	uint uKeepCount = uPoints;
+	if (uPoints <= 4)
+	{
+		for (uint i = 0; i < uPoints; i++)
+			uKeep[i] = i;
+	}
+	else
+	{
+		for (uint i = 1; i < uPoints; i++)
+			if (fDepth[i] > fDepth[uKeep[0]]) uKeep[0] = i;
+
+		float fFar = -1.0f;
+		for (uint i = 0; i < uPoints; i++)
+		{
+			float fDistance = glm::distance2(v3Point[i], v3Point[uKeep[0]]);
+			if (fDistance > fFar) { fFar = fDistance; uKeep[1] = i; }
+		}
+
+		float fMax = -FLT_MAX;
+		float fMin = FLT_MAX;
+		vector3 v3Edge = v3Point[uKeep[1]] - v3Point[uKeep[0]];
+		for (uint i = 0; i < uPoints; i++)
+		{
+			float fArea = glm::dot(glm::cross(v3Edge, v3Point[i] - v3Point[uKeep[0]]), a_v3Normal);
+			if (fArea > fMax) { fMax = fArea; uKeep[2] = i; }
+			if (fArea < fMin) { fMin = fArea; uKeep[3] = i; }
+		}
+		uKeepCount = 4;
+	}
+
+	//the manifold normal goes from the first body to the second, the depth is the same either way
+	for (uint i = 0; i < uKeepCount; i++)
+	{
+		a_Manifold.m_v3Point[i] = v3Point[uKeep[i]];
+		a_Manifold.m_fPointDepth[i] = fDepth[uKeep[i]];
+	}
+	a_Manifold.m_uPointCount = uKeepCount;
+}
+
+vector3 MyRigidBody::GetSupportGlobal(vector3 a_v3Direction)
+{
+	if (m_pHull != nullptr)
+	{
+		//the direction goes to model space with the transpose, that keeps it right with scaling
+		vector3 v3Local = glm::transpose(matrix3(m_m4ToWorld)) * a_v3Direction;
+		return vector3(m_m4ToWorld * vector4(m_pHull->GetSupport(v3Local), 1.0f));
+	}
+
+	//the corner of the box on the side of the direction along each axis
+	vector3 v3Support = m_v3CenterG;
+	for (uint k = 0; k < 3; k++)
+	{
+		if (glm::dot(m_v3AxisG[k], a_v3Direction) < 0.0f)
+			v3Support -= m_v3AxisG[k] * m_v3HalfWidthG[k];
+		else
+			v3Support += m_v3AxisG[k] * m_v3HalfWidthG[k];
+	}
+	return v3Support;
+}
+//Point of the Minkowski difference of two bodies and the points of each body it came from
+struct MySupportPoint
+{
+	vector3 m_v3Point = ZERO_V3; //point of the first body minus point of the second
+	vector3 m_v3A = ZERO_V3; //point of the first body
+	vector3 m_v3B = ZERO_V3; //point of the second body
+};
+MySupportPoint GetMinkowskiSupport(MyRigidBody* a_pA, MyRigidBody* a_pB, vector3 a_v3Direction)
+{
+	MySupportPoint support;
+	support.m_v3A = a_pA->GetSupportGlobal(a_v3Direction);
+	support.m_v3B = a_pB->GetSupportGlobal(-a_v3Direction);
+	support.m_v3Point = support.m_v3A - support.m_v3B;
+	return support;
+}
+//Reduces the simplex to the feature closest to the origin and gets the direction to look next, the
+//newest point is the first one, returns true if the simplex holds the origin
+bool UpdateSimplex(MySupportPoint* a_Simplex, uint& a_uCount, vector3& a_v3Direction)
+{
+	MySupportPoint a = a_Simplex[0];
+	vector3 v3AO = -a.m_v3Point;
+
+	if (a_uCount == 4)
+	{
+		//the faces that have the newest point, each facing away from the point not in them
+		for (uint i = 1; i < 4; i++)
+		{
+			MySupportPoint b = a_Simplex[i];
+			MySupportPoint c = a_Simplex[i % 3 + 1];
+			MySupportPoint d = a_Simplex[(i + 1) % 3 + 1];
+			vector3 v3Normal = glm::cross(b.m_v3Point - a.m_v3Point, c.m_v3Point - a.m_v3Point);
+			if (glm::dot(v3Normal, d.m_v3Point - a.m_v3Point) > 0.0f)
+				v3Normal = -v3Normal;
+			if (glm::dot(v3Normal, v3AO) > 0.0f)
+			{
+				//the origin is past this face, keep going with the triangle
+				a_Simplex[1] = b;
+				a_Simplex[2] = c;
+				a_uCount = 3;
+				return UpdateSimplex(a_Simplex, a_uCount, a_v3Direction);
+			}
+		}
+		return true;
+	}
+
+	if (a_uCount == 3)
+	{
+		MySupportPoint b = a_Simplex[1];
+		MySupportPoint c = a_Simplex[2];
+		vector3 v3AB = b.m_v3Point - a.m_v3Point;
+		vector3 v3AC = c.m_v3Point - a.m_v3Point;
+		vector3 v3Normal = glm::cross(v3AB, v3AC);
+
+		if (glm::dot(glm::cross(v3Normal, v3AC), v3AO) > 0.0f)
+		{
+			if (glm::dot(v3AC, v3AO) > 0.0f)
+			{
+				//closest to the edge ac
+				a_Simplex[1] = c;
+				a_uCount = 2;
+				a_v3Direction = glm::cross(glm::cross(v3AC, v3AO), v3AC);
+				return false;
+			}
+			a_uCount = 2;
+			return UpdateSimplex(a_Simplex, a_uCount, a_v3Direction);
+		}
+		if (glm::dot(glm::cross(v3AB, v3Normal), v3AO) > 0.0f)
+		{
+			a_uCount = 2;
+			return UpdateSimplex(a_Simplex, a_uCount, a_v3Direction);
+		}
+
+		//closest to the face, wound so the next point goes after it
+		if (glm::dot(v3Normal, v3AO) > 0.0f)
+		{
+			a_v3Direction = v3Normal;
+		}
+		else
+		{
+			a_Simplex[1] = c;
+			a_Simplex[2] = b;
+			a_v3Direction = -v3Normal;
+		}
+		return false;
+	}
+
+	if (a_uCount == 2)
+	{
+		vector3 v3AB = a_Simplex[1].m_v3Point - a.m_v3Point;
+		if (glm::dot(v3AB, v3AO) > 0.0f)
+		{
+			a_v3Direction = glm::cross(glm::cross(v3AB, v3AO), v3AB);
+			return false;
+		}
+	}
+
+	a_uCount = 1;
+	a_v3Direction = v3AO;
+	return false;
+}
+//Adds points to the simplex until it is a tetrahedron, for when GJK got to the origin with fewer points,
+//returns false if the Minkowski difference is flat
+bool CompleteSimplex(MyRigidBody* a_pA, MyRigidBody* a_pB, MySupportPoint* a_Simplex, uint& a_uCount)
+{
+	static const float fEpsilon = 0.00001f;
+	static const vector3 v3Axis[6] = { AXIS_X, -AXIS_X, AXIS_Y, -AXIS_Y, AXIS_Z, -AXIS_Z };
+	while (a_uCount < 4)
+	{
+		vector3 v3Search[6];
+		uint uSearch = 0;
+		if (a_uCount == 1)
+		{
+			for (uint i = 0; i < 6; i++)
+				v3Search[uSearch++] = v3Axis[i];
+		}
+		else if (a_uCount == 2)
+		{
+			//around the line, starting from the axis least aligned to it
+			vector3 v3Line = a_Simplex[1].m_v3Point - a_Simplex[0].m_v3Point;
+			vector3 v3Abs = glm::abs(v3Line);
+			vector3 v3Least = v3Abs.x < v3Abs.y ? (v3Abs.x < v3Abs.z ? AXIS_X : AXIS_Z) : (v3Abs.y < v3Abs.z ? AXIS_Y : AXIS_Z);
+			vector3 v3U = glm::cross(v3Line, v3Least);
+			vector3 v3V = glm::cross(v3Line, v3U);
+			v3Search[uSearch++] = v3U;
+			v3Search[uSearch++] = -v3U;
+			v3Search[uSearch++] = v3V;
+			v3Search[uSearch++] = -v3V;
+		}
+		else
+		{
+			vector3 v3Normal = glm::cross(a_Simplex[1].m_v3Point - a_Simplex[0].m_v3Point,
+				a_Simplex[2].m_v3Point - a_Simplex[0].m_v3Point);
+			v3Search[uSearch++] = v3Normal;
+			v3Search[uSearch++] = -v3Normal;
+		}
+
+		bool bAdded = false;
+		for (uint i = 0; i < uSearch && !bAdded; i++)
+		{
+			MySupportPoint support = GetMinkowskiSupport(a_pA, a_pB, v3Search[i]);
+
+			//how far the point is from the point, line or plane of the simplex
+			vector3 v3Offset = support.m_v3Point - a_Simplex[0].m_v3Point;
+			float fDistance = glm::length(v3Offset);
+			if (a_uCount == 2)
+				fDistance = glm::length(glm::cross(v3Offset, glm::normalize(a_Simplex[1].m_v3Point - a_Simplex[0].m_v3Point)));
+			else if (a_uCount == 3)
+				fDistance = glm::abs(glm::dot(v3Offset, glm::normalize(v3Search[0])));
+
+			if (fDistance > fEpsilon)
+			{
+				a_Simplex[a_uCount++] = support;
+				bAdded = true;
+			}
+		}
+		if (!bAdded)
+			return false;
+	}
+	return true;
+}
+//Triangle of the polytope EPA expands
+struct MyPolytopeFace
+{
+	uint m_uVertex[3]; //points of the polytope
+	vector3 m_v3Normal = ZERO_V3; //normal pointing out of the polytope
+	float m_fDistance = 0.0f; //distance from the origin to the plane of the face
+};
+bool MakePolytopeFace(std::vector<MySupportPoint> const& a_lPoint, vector3 a_v3Inside, uint a_uA, uint a_uB, uint a_uC,
+	MyPolytopeFace& a_Face)
+{
+	vector3 v3Normal = glm::cross(a_lPoint[a_uB].m_v3Point - a_lPoint[a_uA].m_v3Point,
+		a_lPoint[a_uC].m_v3Point - a_lPoint[a_uA].m_v3Point);
+	float fLength = glm::length(v3Normal);
+	if (fLength < 0.0000001f)
+		return false;
+	v3Normal /= fLength;
+
+	//facing away from a point inside the polytope
+	if (glm::dot(v3Normal, a_lPoint[a_uA].m_v3Point - a_v3Inside) < 0.0f)
+	{
+		v3Normal = -v3Normal;
+		std::swap(a_uB, a_uC);
+	}
+	a_Face.m_uVertex[0] = a_uA;
+	a_Face.m_uVertex[1] = a_uB;
+	a_Face.m_uVertex[2] = a_uC;
+	a_Face.m_v3Normal = v3Normal;
+	a_Face.m_fDistance = glm::dot(v3Normal, a_lPoint[a_uA].m_v3Point);
+	return true;
+}
+bool MyRigidBody::GetHullManifold(MyRigidBody* const a_pOther, MyManifold& a_Manifold)
+{
+	//GJK, look for a tetrahedron of the Minkowski difference around the origin
+	MySupportPoint simplex[4];
+	uint uCount = 1;
+	vector3 v3Direction = m_v3CenterG - a_pOther->m_v3CenterG;
+	if (glm::dot(v3Direction, v3Direction) < 0.0000001f)
+		v3Direction = AXIS_X;
+	simplex[0] = GetMinkowskiSupport(this, a_pOther, v3Direction);
+	v3Direction = -simplex[0].m_v3Point;
+
+	bool bContained = false;
+	for (uint uIteration = 0; uIteration < 64 && !bContained; uIteration++)
+	{
+		//the origin is on the simplex, they are touching
+		if (glm::dot(v3Direction, v3Direction) < 0.0000001f)
+		{
+			bContained = true;
+			break;
+		}
+
+		MySupportPoint support = GetMinkowskiSupport(this, a_pOther, v3Direction);
+		if (glm::dot(support.m_v3Point, v3Direction) <= 0.0f)
+			return false;
+
+		for (uint i = uCount; i > 0; i--)
+			simplex[i] = simplex[i - 1];
+		simplex[0] = support;
+		uCount++;
+		bContained = UpdateSimplex(simplex, uCount, v3Direction);
+	}
+	//out of iterations without closing around the origin, there is no simplex for EPA to start from
+	if (!bContained)
+		return false;
+	if (!CompleteSimplex(this, a_pOther, simplex, uCount))
+		return false;
+
+	//EPA, push the face of the polytope closest to the origin out until it is on the surface
+	std::vector<MySupportPoint> lPoint(simplex, simplex + 4);
+	vector3 v3Inside = (lPoint[0].m_v3Point + lPoint[1].m_v3Point + lPoint[2].m_v3Point + lPoint[3].m_v3Point) * 0.25f;
+	std::vector<MyPolytopeFace> lFace;
+	uint uTetrahedron[4][3] = { { 0, 1, 2 }, { 0, 1, 3 }, { 0, 2, 3 }, { 1, 2, 3 } };
+	for (uint f = 0; f < 4; f++)
+	{
+		MyPolytopeFace face;
+		if (MakePolytopeFace(lPoint, v3Inside, uTetrahedron[f][0], uTetrahedron[f][1], uTetrahedron[f][2], face))
+			lFace.push_back(face);
+	}
+
+	uint uClosest = 0;
+	std::vector<std::pair<uint, uint>> lEdge;
+	for (uint uIteration = 0; uIteration < 64 && !lFace.empty(); uIteration++)
+	{
+		uClosest = 0;
+		for (uint f = 1; f < lFace.size(); f++)
+		{
+			if (lFace[f].m_fDistance < lFace[uClosest].m_fDistance)
+				uClosest = f;
+		}
+
+		//nothing further out along the normal, this face is on the surface
+		vector3 v3Normal = lFace[uClosest].m_v3Normal;
+		MySupportPoint support = GetMinkowskiSupport(this, a_pOther, v3Normal);
+		if (glm::dot(support.m_v3Point, v3Normal) - lFace[uClosest].m_fDistance < 0.0001f)
+			break;
+
+		//remove the faces the new point can see, the edges only one of them had are the border of the hole
+		uint uNew = lPoint.size();
+		lPoint.push_back(support);
+		lEdge.clear();
+		for (uint f = 0; f < lFace.size();)
+		{
+			if (glm::dot(lFace[f].m_v3Normal, support.m_v3Point - lPoint[lFace[f].m_uVertex[0]].m_v3Point) > 0.0f)
+			{
+				for (uint e = 0; e < 3; e++)
+				{
+					std::pair<uint, uint> edge(lFace[f].m_uVertex[e], lFace[f].m_uVertex[(e + 1) % 3]);
+					std::pair<uint, uint> reversed(edge.second, edge.first);
+					std::vector<std::pair<uint, uint>>::iterator it = std::find(lEdge.begin(), lEdge.end(), reversed);
+					if (it == lEdge.end())
+						it = std::find(lEdge.begin(), lEdge.end(), edge);
+					if (it != lEdge.end())
+						lEdge.erase(it);
+					else
+						lEdge.push_back(edge);
+				}
+				lFace[f] = lFace.back();
+				lFace.pop_back();
+			}
+			else
+				f++;
+		}
+
+		for (uint e = 0; e < lEdge.size(); e++)
+		{
+			MyPolytopeFace face;
+			if (MakePolytopeFace(lPoint, v3Inside, lEdge[e].first, lEdge[e].second, uNew, face))
+				lFace.push_back(face);
+		}
+	}
+	if (lFace.empty())
+		return false;
+
+	//out of iterations the faces changed after the closest one was picked, it is picked again from the ones left
+	uClosest = 0;
+	for (uint f = 1; f < lFace.size(); f++)
+	{
+		if (lFace[f].m_fDistance < lFace[uClosest].m_fDistance)
+			uClosest = f;
+	}
+
+	//closest point of the face to the origin in barycentric coordinates, to get the point on each body
+	MyPolytopeFace& face = lFace[uClosest];
+	MySupportPoint const& a = lPoint[face.m_uVertex[0]];
+	MySupportPoint const& b = lPoint[face.m_uVertex[1]];
+	MySupportPoint const& c = lPoint[face.m_uVertex[2]];
+	vector3 v3Projection = face.m_v3Normal * face.m_fDistance;
+	vector3 v3AB = b.m_v3Point - a.m_v3Point;
+	vector3 v3AC = c.m_v3Point - a.m_v3Point;
+	vector3 v3AP = v3Projection - a.m_v3Point;
+	float fABAB = glm::dot(v3AB, v3AB);
+	float fABAC = glm::dot(v3AB, v3AC);
+	float fACAC = glm::dot(v3AC, v3AC);
+	float fDenominator = fABAB * fACAC - fABAC * fABAC;
+	float fV = 0.0f;
+	float fW = 0.0f;
+	if (fDenominator > 0.0f)
+	{
+		float fAPAB = glm::dot(v3AP, v3AB);
+		float fAPAC = glm::dot(v3AP, v3AC);
+		fV = glm::clamp((fACAC * fAPAB - fABAC * fAPAC) / fDenominator, 0.0f, 1.0f);
+		fW = glm::clamp((fABAB * fAPAC - fABAC * fAPAB) / fDenominator, 0.0f, 1.0f - fV);
+	}
+	float fU = 1.0f - fV - fW;
+	vector3 v3PointA = a.m_v3A * fU + b.m_v3A * fV + c.m_v3A * fW;
+	vector3 v3PointB = a.m_v3B * fU + b.m_v3B * fV + c.m_v3B * fW;
+
+	//moving this body back along the normal by the depth takes the origin out of the difference
+	a_Manifold.m_v3Normal = face.m_v3Normal;
+	a_Manifold.m_fDepth = glm::max(face.m_fDistance, 0.0f);
+	a_Manifold.m_uAxis = eSATResults::SAT_NONE;
+	a_Manifold.m_uPointCount = 1;
+	a_Manifold.m_v3Point[0] = (v3PointA + v3PointB) * 0.5f;
+	a_Manifold.m_fPointDepth[0] = a_Manifold.m_fDepth;
+	return true;
+}
 void MyRigidBody::AddToRenderList(void)
 {
 	if (m_bVisibleBS)
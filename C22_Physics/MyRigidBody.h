@@ -5,11 +5,22 @@ Date: 2017/06
 #ifndef __MYRIGIDBODY_H_
 #define __MYRIGIDBODY_H_
 
-#include "Simplex\Mesh\Model.h"
+#include "MyConvexHull.h"
 
 namespace Simplex
 {
 
+//Contact between two rigid bodies
+struct MyManifold
+{
+	vector3 m_v3Normal = ZERO_V3; //axis of least penetration, from the first body to the second
+	float m_fDepth = 0.0f; //how far the bodies go into each other along the normal
+	uint m_uAxis = 0; //eSATResults of the axis of least penetration, SAT_NONE when it comes from the convex hulls
+	uint m_uPointCount = 0; //contact points used, up to 4
+	vector3 m_v3Point[4]; //contact points in global space, halfway between the two surfaces
+	float m_fPointDepth[4] = { 0.0f, 0.0f, 0.0f, 0.0f }; //penetration at each contact point
+};
+
 //System Class
 class MyRigidBody
 {
@@ -42,6 +53,11 @@ protected:
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Matrix that will take us from local to world coordinate
 
+	vector3 m_v3AxisG[3]; //normalized axes of the Oriented Bounding Box in global space
+	vector3 m_v3HalfWidthG = ZERO_V3; //half width scaled by the model matrix, along the global axes
+
+	MyConvexHull* m_pHull = nullptr; //convex hull of the model, shared by the bodies of the same model, not owned
+
 	uint m_uCollidingCount = 0; //size of the colliding set
 	PRigidBody* m_CollidingArray = nullptr; //array of rigid bodies this one is colliding with
 
@@ -111,6 +127,30 @@ public:
 	OUTPUT: are they colliding?
 	*/
 	bool IsColliding(MyRigidBody* const other);
+
+	/*
+	USAGE: Tests the Oriented Bounding Boxes against each other and if they overlap gets the contact,
+	the axis where they go into each other the least, how much, and up to 4 contact points from
+	clipping the face of one box against the other, if either body has a convex hull the boxes
+	overlapping is only the first check and the contact comes from GJK and EPA on the hulls
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body to test against
+	-	MyManifold& a_Manifold -> out: contact, the normal goes from this body to the other
+	OUTPUT: are they overlapping?
+	*/
+	bool GetManifold(MyRigidBody* const a_pOther, MyManifold& a_Manifold);
+
+	/*
+	USAGE: Sweeps the axis (re)aligned bounding box back along the displacement of the last step and
+	finds when it first touched the box of the other body, which is swept back along its own
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body to test against
+	-	vector3 a_v3Displacement -> how much this body moved in the step minus how much the other one did
+	-	float& a_fTime -> out: fraction of the step when they touched, 0 at the start and 1 at the end
+	-	vector3& a_v3Normal -> out: normal of the face hit, from this body to the other
+	OUTPUT: did they touch during the step without overlapping at the start of it?
+	*/
+	bool SweepARBB(MyRigidBody* const a_pOther, vector3 a_v3Displacement, float& a_fTime, vector3& a_v3Normal);
 #pragma region Accessors
 	/*
 	Usage: Gets visibility of bounding sphere
@@ -221,6 +261,30 @@ public:
 	*/
 	vector3 GetHalfWidth(void);
 	/*
+	Usage: Gets the half width scaled by the model matrix, along the axes in global space
+	Arguments: ---
+	Output: halfwidth vector
+	*/
+	vector3 GetHalfWidthGlobal(void);
+	/*
+	Usage: Gets one of the normalized axes of the Oriented Bounding Box in global space
+	Arguments: uint a_uAxis -> 0 for x, 1 for y, 2 for z
+	Output: axis
+	*/
+	vector3 GetAxisGlobal(uint a_uAxis);
+	/*
+	Usage: Gets the convex hull used for collisions
+	Arguments: ---
+	Output: hull, nullptr if the Oriented Bounding Box is used
+	*/
+	MyConvexHull* GetConvexHull(void);
+	/*
+	Usage: Sets the convex hull used for collisions, the body does not own it
+	Arguments: MyConvexHull* a_pHull -> hull of the model, nullptr to use the Oriented Bounding Box
+	Output: ---
+	*/
+	void SetConvexHull(MyConvexHull* a_pHull);
+	/*
 	Usage: Gets Model to World matrix
 	Arguments: ---
 	Output: model to world matrix
@@ -251,6 +315,13 @@ public:
 	OUTPUT: is it in the array?
 	*/
 	bool IsInCollidingArray(MyRigidBody* a_pEntry);
+	/*
+	USAGE: Gets the point of the body that is the furthest along a direction, from the convex hull
+	if it has one or from the Oriented Bounding Box if it does not
+	ARGUMENTS: vector3 a_v3Direction -> direction in global space
+	OUTPUT: point in global space
+	*/
+	vector3 GetSupportGlobal(vector3 a_v3Direction);
 	
 private:
 	/*
@@ -266,11 +337,39 @@ private:
 	*/
 	void Init(void);
 	/*
+	USAGE: Calculates the axes and half width in global space from the model matrix
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateGlobalOBB(void);
+	/*
+	USAGE: Finds the contact points when the least penetration is along the axis of a face, clipping
+	the face of the incident box most opposed to it against the sides of the reference face
+	ARGUMENTS:
+	-	MyRigidBody* const a_pReference -> box that owns the face
+	-	MyRigidBody* const a_pIncident -> box whose face is clipped
+	-	vector3 a_v3Normal -> normal of the reference face, pointing to the incident box
+	-	uint a_uAxis -> axis of the reference box the face belongs to
+	-	MyManifold& a_Manifold -> out: contact points and their depth
+	OUTPUT: ---
+	*/
+	static void ClipFace(MyRigidBody* const a_pReference, MyRigidBody* const a_pIncident, vector3 a_v3Normal,
+		uint a_uAxis, MyManifold& a_Manifold);
+	/*
 	USAGE: This will apply the Separation Axis Test
 	ARGUMENTS: MyRigidBody* const a_pOther -> other rigid body to test against
 	OUTPUT: 0 for colliding, all other first axis that succeeds test
 	*/
 	uint SAT(MyRigidBody* const a_pOther);
+	/*
+	USAGE: Tests the shapes with GJK and if they overlap expands the last simplex with EPA to get the
+	normal and depth of the contact, with one contact point halfway between the two surfaces
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body to test against
+	-	MyManifold& a_Manifold -> out: contact, the normal goes from this body to the other
+	OUTPUT: are they overlapping?
+	*/
+	bool GetHullManifold(MyRigidBody* const a_pOther, MyManifold& a_Manifold);
 };//class
 
 } //namespace Simplex
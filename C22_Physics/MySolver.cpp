@@ -3,27 +3,32 @@ using namespace Simplex;
 //  MySolver
 void MySolver::Init(void)
 {
-	m_v3Acceleration = ZERO_V3;
-	m_v3Position = ZERO_V3;
-	m_v3Velocity = ZERO_V3;
-	m_fMass = 1.0f;
+	m_pWorld = MyPhysicsWorld::GetInstance();
+	m_uBody = -1;
 }
 void MySolver::Swap(MySolver& other)
 {
-	std::swap(m_v3Acceleration, other.m_v3Acceleration);
-	std::swap(m_v3Velocity, other.m_v3Velocity);
-	std::swap(m_v3Position, other.m_v3Position);
-	std::swap(m_fMass, other.m_fMass);
+	std::swap(m_pWorld, other.m_pWorld);
+	std::swap(m_uBody, other.m_uBody);
+}
+void MySolver::Release(void)
+{
+	//give the body back to the world
+	if (m_uBody != static_cast<uint>(-1))
+		m_pWorld->RemoveBody(m_uBody);
+	m_uBody = -1;
 }
-void MySolver::Release(void){/*nothing to deallocate*/ }
 //The big 3
-MySolver::MySolver(void){ Init(); }
+MySolver::MySolver(void)
+{
+	Init();
+	m_uBody = m_pWorld->AddBody();
+}
 MySolver::MySolver(MySolver const& other)
 {
-	m_v3Acceleration = other.m_v3Acceleration;
-	m_v3Velocity = other.m_v3Velocity;
-	m_v3Position = other.m_v3Position;
-	m_fMass = other.m_fMass;
+	Init();
+	m_uBody = m_pWorld->AddBody();
+	m_pWorld->CopyBody(other.m_uBody, m_uBody);
 }
 MySolver& MySolver::operator=(MySolver const& other)
 {
@@ -39,17 +44,35 @@ MySolver& MySolver::operator=(MySolver const& other)
 MySolver::~MySolver() { Release(); }
 
 //Accessors
-void MySolver::SetPosition(vector3 a_v3Position) { m_v3Position = a_v3Position; }
-vector3 MySolver::GetPosition(void) { return m_v3Position; }
+uint MySolver::GetBody(void) { return m_uBody; }
+
+void MySolver::SetPosition(vector3 a_v3Position)
+{
+	m_pWorld->SetPosition(m_uBody, a_v3Position);
+	//the update never moves a body that is not simulated, where it is put is where it was
+	if (!m_pWorld->GetSimulated(m_uBody))
+		m_pWorld->SetLastPosition(m_uBody, a_v3Position);
+}
+vector3 MySolver::GetPosition(void) { return m_pWorld->GetPosition(m_uBody); }
+
+void MySolver::SetSize(vector3 a_v3Size) { m_pWorld->SetSize(m_uBody, a_v3Size); }
+vector3 MySolver::GetSize(void) { return m_pWorld->GetSize(m_uBody); }
+
+void MySolver::SetVelocity(vector3 a_v3Velocity) { m_pWorld->SetVelocity(m_uBody, a_v3Velocity); }
+vector3 MySolver::GetVelocity(void) { return m_pWorld->GetVelocity(m_uBody); }
 
-void MySolver::SetSize(vector3 a_v3Size) { m_v3Size = a_v3Size; }
-vector3 MySolver::GetSize(void) { return m_v3Size; }
+void MySolver::SetMass(float a_fMass) { m_pWorld->SetMass(m_uBody, a_fMass); }
+float MySolver::GetMass(void) { return m_pWorld->GetMass(m_uBody); }
 
-void MySolver::SetVelocity(vector3 a_v3Velocity) { m_v3Velocity = a_v3Velocity; }
-vector3 MySolver::GetVelocity(void) { return m_v3Velocity; }
+void MySolver::SetSimulated(bool a_bSimulated) { m_pWorld->SetSimulated(m_uBody, a_bSimulated); }
+bool MySolver::GetSimulated(void) { return m_pWorld->GetSimulated(m_uBody); }
+matrix4 MySolver::GetModelMatrix(void) { return m_pWorld->GetModelMatrix(m_uBody); }
+bool MySolver::IsAwake(void) { return m_pWorld->IsAwake(m_uBody); }
+void MySolver::Wake(void) { m_pWorld->WakeBody(m_uBody); }
 
-void MySolver::SetMass(float a_fMass) { m_fMass = a_fMass; }
-float MySolver::GetMass(void) { return m_fMass; }
+void MySolver::SetContinuous(bool a_bContinuous) { m_pWorld->SetContinuous(m_uBody, a_bContinuous); }
+bool MySolver::GetContinuous(void) { return m_pWorld->GetContinuous(m_uBody); }
+vector3 MySolver::GetDisplacement(void) { return m_pWorld->GetPosition(m_uBody) - m_pWorld->GetLastPosition(m_uBody); }
 
 //Methods
 void MySolver::ApplyFriction(float a_fFriction)
@@ -57,77 +80,71 @@ void MySolver::ApplyFriction(float a_fFriction)
 	if (a_fFriction < 0.01f)
 		a_fFriction = 0.01f;
 	
-	m_v3Velocity *= 1.0f - a_fFriction;
+	vector3 v3Velocity = GetVelocity() * (1.0f - a_fFriction);
 
 	//if velocity is really small make it zero
-	if (glm::length(m_v3Velocity) < 0.01f)
-		m_v3Velocity = ZERO_V3;
+	if (glm::length(v3Velocity) < 0.01f)
+		v3Velocity = ZERO_V3;
+	SetVelocity(v3Velocity);
 }
 void MySolver::ApplyForce(vector3 a_v3Force)
 {
 	//check minimum mass
-	if (m_fMass < 0.01f)
-		m_fMass = 0.01f;
+	float fMass = GetMass();
+	if (fMass < 0.01f)
+	{
+		fMass = 0.01f;
+		SetMass(fMass);
+	}
 	//f = m * a -> a = f / m
-	m_v3Acceleration += a_v3Force / m_fMass;
+	m_pWorld->WakeBody(m_uBody);
+	m_pWorld->SetAcceleration(m_uBody, m_pWorld->GetAcceleration(m_uBody) + a_v3Force / fMass);
 }
-vector3 CalculateMaxVelocity(vector3 a_v3Velocity, float maxVelocity)
+void MySolver::Update(void)
 {
-	if (glm::length(a_v3Velocity) > maxVelocity)
-	{
-		a_v3Velocity = glm::normalize(a_v3Velocity);
-		a_v3Velocity *= maxVelocity;
-	}
-	return a_v3Velocity;
+	m_pWorld->UpdateBody(m_uBody);
 }
-vector3 RoundSmallVelocity(vector3 a_v3Velocity, float minVelocity = 0.01f)
+void MySolver::AddContact(MySolver* a_pOther, MyManifold const& a_Manifold)
 {
-	if (glm::length(a_v3Velocity) < minVelocity)
-	{
-		a_v3Velocity = ZERO_V3;
-	}
-	return a_v3Velocity;
+	//the entity manager only resolves a sleeping solver against an awake one, the world wakes it
+	m_pWorld->AddContact(m_uBody, a_pOther->m_uBody, a_Manifold.m_v3Normal, a_Manifold.m_fDepth);
 }
-void MySolver::Update(void)
+void MySolver::ResolveCollision(MySolver* a_pOther, MyManifold const& a_Manifold)
 {
-	ApplyForce(vector3(0.0f, -0.035f, 0.0f));
-
-	m_v3Velocity += m_v3Acceleration;
-	
-	float fMaxVelocity = 5.0f;
-	m_v3Velocity = CalculateMaxVelocity(m_v3Velocity, fMaxVelocity);
+	if (!IsAwake())
+		Wake();
+	if (!a_pOther->IsAwake())
+		a_pOther->Wake();
 
-	ApplyFriction(0.1f);
-	m_v3Velocity = RoundSmallVelocity(m_v3Velocity, 0.028f);
+	//this one is pushed against the normal and the other one along it
+	vector3 v3Normal = a_Manifold.m_v3Normal;
+	vector3 v3Position = GetPosition();
+	vector3 v3OtherPosition = a_pOther->GetPosition();
+	float fInvMassThis = m_pWorld->GetInverseMass(m_uBody, -v3Normal);
+	float fInvMassOther = m_pWorld->GetInverseMass(a_pOther->m_uBody, v3Normal);
+	float fInvMassSum = fInvMassThis + fInvMassOther;
+	if (fInvMassSum == 0.0f)
+		return;
 
-	m_v3Position += m_v3Velocity;
-			
-	if (m_v3Position.y <= 0)
+	//if they are moving into each other cancel that part of the velocity, with a small bounce
+	float fRestitution = 0.1f;
+	vector3 v3Velocity = GetVelocity();
+	vector3 v3OtherVelocity = a_pOther->GetVelocity();
+	float fApproach = glm::dot(v3OtherVelocity - v3Velocity, v3Normal);
+	if (fApproach < 0.0f)
 	{
-		m_v3Position.y = 0;
-		m_v3Velocity.y = 0;
+		float fImpulse = -(1.0f + fRestitution) * fApproach / fInvMassSum;
+		SetVelocity(v3Velocity - v3Normal * (fImpulse * fInvMassThis));
+		a_pOther->SetVelocity(v3OtherVelocity + v3Normal * (fImpulse * fInvMassOther));
 	}
 
-	m_v3Acceleration = ZERO_V3;
-}
-void MySolver::ResolveCollision(MySolver* a_pOther)
-{
-	float fMagThis = glm::length(m_v3Velocity);
-	float fMagOther = glm::length(m_v3Velocity);
-
-	if (fMagThis > 0.015f || fMagOther > 0.015f)
-	{
-		//a_pOther->ApplyForce(GetVelocity());
-		ApplyForce(-m_v3Velocity);
-		a_pOther->ApplyForce(m_v3Velocity);
-	}
-	else
+	//take them out of each other now instead of over the next frames, a small overlap is left so the contact is kept
+	float fSlop = 0.01f;
+	float fCorrection = a_Manifold.m_fDepth - fSlop;
+	if (fCorrection > 0.0f)
 	{
-		vector3 v3Direction = m_v3Position - a_pOther->m_v3Position;
-		if(glm::length(v3Direction) != 0)
-			v3Direction = glm::normalize(v3Direction);
-		v3Direction *= 0.04f;
-		ApplyForce(v3Direction);
-		a_pOther->ApplyForce(-v3Direction);
+		vector3 v3Correction = v3Normal * (fCorrection / fInvMassSum);
+		SetPosition(v3Position - v3Correction * fInvMassThis);
+		a_pOther->SetPosition(v3OtherPosition + v3Correction * fInvMassOther);
 	}
 }
\ No newline at end of file
@@ -6,17 +6,15 @@ Date: 2017/07
 #define __MYSOLVER_H_
 
 #include "MyRigidBody.h"
+#include "MyPhysicsWorld.h"
 
 namespace Simplex
 {
 
 class MySolver
 {
-	vector3 m_v3Acceleration = ZERO_V3; //Acceleration of the MySolver
-	vector3 m_v3Position = ZERO_V3; //Position of the MySolver
-	vector3 m_v3Size = vector3(1.0f); //Size of the MySolver
-	vector3 m_v3Velocity = ZERO_V3; //Velocity of the MySolver
-	float m_fMass = 1.0f; //Mass of the solver
+	MyPhysicsWorld* m_pWorld = nullptr; //World holding the state of the MySolver
+	uint m_uBody = -1; //Index of the body of the MySolver in the world
 public:
 	/*
 	USAGE: Constructor
@@ -50,7 +48,14 @@ public:
 	void Swap(MySolver& other);
 
 	/*
-	USAGE: Sets the position of the solver
+	USAGE: Gets the index of the body of the solver in the physics world
+	ARGUMENTS: ---
+	OUTPUT: index of the body
+	*/
+	uint GetBody(void);
+
+	/*
+	USAGE: Sets the position of the solver, a body that is not simulated did not move to get there
 	ARGUMENTS: vector3 a_v3Position -> position to set
 	OUTPUT: ---
 	*/
@@ -101,6 +106,56 @@ public:
 	*/
 	float GetMass(void);
 
+	/*
+	USAGE: Sets if the physics world moves the solver on its update
+	ARGUMENTS: bool a_bSimulated -> is it moved by the update?
+	OUTPUT: ---
+	*/
+	void SetSimulated(bool a_bSimulated);
+	/*
+	USAGE: Gets if the physics world moves the solver on its update
+	ARGUMENTS: ---
+	OUTPUT: is it moved by the update?
+	*/
+	bool GetSimulated(void);
+	/*
+	USAGE: Asks if the solver is awake, a sleeping solver is not moved until something wakes it
+	ARGUMENTS: ---
+	OUTPUT: is it awake?
+	*/
+	bool IsAwake(void);
+	/*
+	USAGE: Wakes the solver and the ones it fell asleep with
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Wake(void);
+	/*
+	USAGE: Gets the model matrix the physics world wrote for the solver on its last update
+	ARGUMENTS: ---
+	OUTPUT: translation times scale of the solver
+	*/
+	matrix4 GetModelMatrix(void);
+
+	/*
+	USAGE: Sets if the solver checks for collisions along the way when it moves fast
+	ARGUMENTS: bool a_bContinuous -> check along the way?
+	OUTPUT: ---
+	*/
+	void SetContinuous(bool a_bContinuous);
+	/*
+	USAGE: Gets if the solver checks for collisions along the way when it moves fast
+	ARGUMENTS: ---
+	OUTPUT: check along the way?
+	*/
+	bool GetContinuous(void);
+	/*
+	USAGE: Gets how much the solver moved in the last update
+	ARGUMENTS: ---
+	OUTPUT: displacement of the last update
+	*/
+	vector3 GetDisplacement(void);
+
 	/*
 	USAGE: Applies friction to the movement
 	ARGUMENTS: float a_fFriction = 0.1f -> friction to apply negative friction gets minimized to 0.01f
@@ -108,23 +163,36 @@ public:
 	*/
 	void ApplyFriction(float a_fFriction = 0.1f);
 	/*
-	USAGE: Applies a force to the solver
+	USAGE: Applies a force to the solver, waking it
 	ARGUMENTS: vector3 a_v3Force -> Force to apply
 	OUTPUT: ---
 	*/
 	void ApplyForce(vector3 a_v3Force);
 	/*
-	USAGE: Updates the MySolver
+	USAGE: Updates the MySolver by itself, the physics world updates all of them at once
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
-	USAGE: Resolve the collision between two solvers
-	ARGUMENTS: MySolver* a_pOther -> other solver to resolve collision with
+	USAGE: Adds the contact between two solvers to the physics world, which solves it together with the
+	rest on its next update; a sleeping solver is woken and the contact joins their islands
+	ARGUMENTS:
+	-	MySolver* a_pOther -> other solver in contact
+	-	MyManifold const& a_Manifold -> contact between the two, the normal goes from this one to the other
+	OUTPUT: ---
+	*/
+	void AddContact(MySolver* a_pOther, MyManifold const& a_Manifold);
+	/*
+	USAGE: Resolve the collision between two solvers in one step, stops them from moving into each
+	other along the normal of the contact and moves them apart by its depth, the heavier one moving less;
+	used for the contacts found after the update, a sleeping solver is woken
+	ARGUMENTS:
+	-	MySolver* a_pOther -> other solver to resolve collision with
+	-	MyManifold const& a_Manifold -> contact between the two, the normal goes from this one to the other
 	OUTPUT: ---
 	*/
-	void ResolveCollision(MySolver* a_pOther);
+	void ResolveCollision(MySolver* a_pOther, MyManifold const& a_Manifold);
 private:
 	/*
 	Usage: Deallocates member fields
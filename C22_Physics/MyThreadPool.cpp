@@ -0,0 +1,106 @@
+#include "MyThreadPool.h"
+using namespace Simplex;
+//  MyThreadPool
+Simplex::MyThreadPool* Simplex::MyThreadPool::m_pInstance = nullptr;
+void Simplex::MyThreadPool::Init(void)
+{
+	m_lTask.clear();
+	m_uPending = 0;
+	m_bStop = false;
+
+	//the thread that calls Wait also works, so it does not need a worker of its own
+	uint uCores = std::thread::hardware_concurrency();
+	for (uint i = 1; i < uCores; i++)
+	{
+		m_lWorker.push_back(std::thread(&MyThreadPool::WorkerLoop, this));
+	}
+}
+void Simplex::MyThreadPool::Release(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bStop = true;
+	}
+	m_TaskAdded.notify_all();
+	for (uint i = 0; i < m_lWorker.size(); i++)
+	{
+		m_lWorker[i].join();
+	}
+	m_lWorker.clear();
+	m_lTask.clear();
+	m_uPending = 0;
+}
+Simplex::MyThreadPool* Simplex::MyThreadPool::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyThreadPool();
+	}
+	return m_pInstance;
+}
+void Simplex::MyThreadPool::ReleaseInstance(void)
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyThreadPool::MyThreadPool(void) { Init(); }
+Simplex::MyThreadPool::MyThreadPool(MyThreadPool const& other) { }
+Simplex::MyThreadPool& Simplex::MyThreadPool::operator=(MyThreadPool const& other) { return *this; }
+Simplex::MyThreadPool::~MyThreadPool(void) { Release(); }
+//Accessors
+Simplex::uint Simplex::MyThreadPool::GetThreadCount(void) { return m_lWorker.size() + 1; }
+//--- Non Standard Singleton Methods
+void Simplex::MyThreadPool::Run(Task a_Task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_lTask.push_back(std::move(a_Task));
+		++m_uPending;
+	}
+	m_TaskAdded.notify_one();
+}
+void Simplex::MyThreadPool::Wait(void)
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (m_uPending > 0)
+	{
+		//help with the queue instead of sleeping
+		if (!m_lTask.empty())
+		{
+			Task task = std::move(m_lTask.front());
+			m_lTask.pop_front();
+			lock.unlock();
+			Execute(task);
+			lock.lock();
+			continue;
+		}
+		m_TaskDone.wait(lock);
+	}
+}
+void Simplex::MyThreadPool::WorkerLoop(void)
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (true)
+	{
+		m_TaskAdded.wait(lock, [this] { return m_bStop || !m_lTask.empty(); });
+		if (m_lTask.empty()) return; //stopped
+
+		Task task = std::move(m_lTask.front());
+		m_lTask.pop_front();
+		lock.unlock();
+		Execute(task);
+		lock.lock();
+	}
+}
+void Simplex::MyThreadPool::Execute(Task& a_Task)
+{
+	a_Task();
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (--m_uPending == 0)
+		m_TaskDone.notify_all();
+}
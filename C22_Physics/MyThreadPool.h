@@ -0,0 +1,126 @@
+/*----------------------------------------------
+Programmer: Dexter Delandro (dmd7488@g.rit.edu)
+Date: 2020
+---------------------------------------------*/
+#ifndef __MYTHREADPOOLCLASS_H_
+#define __MYTHREADPOOLCLASS_H_
+
+#include "Simplex\Simplex.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyThreadPool
+	{
+		typedef std::function<void(void)> Task; //work given to the pool
+
+		static MyThreadPool* m_pInstance; // Singleton pointer
+
+		std::vector<std::thread> m_lWorker; //threads waiting for tasks
+		std::deque<Task> m_lTask; //tasks not taken by any thread yet
+		uint m_uPending = 0; //tasks queued or running
+		bool m_bStop = false; //tells the workers to finish
+
+		std::mutex m_Mutex; //guards the queue, the pending count and the stop flag
+		std::condition_variable m_TaskAdded; //wakes the workers when there is work
+		std::condition_variable m_TaskDone; //wakes Wait when the last task finishes
+
+	public:
+		/*
+		USAGE: Gets the singleton pointer, the first call starts the threads
+		ARGUMENTS: ---
+		OUTPUT: singleton pointer
+		*/
+		static MyThreadPool* GetInstance(void);
+		/*
+		USAGE: Finishes the threads and releases the singleton
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void ReleaseInstance(void);
+		/*
+		USAGE: Queues a task for the next free thread, tasks can queue more tasks
+		ARGUMENTS: Task a_Task -> work to do
+		OUTPUT: ---
+		*/
+		void Run(Task a_Task);
+		/*
+		USAGE: Blocks until every task queued (and every task they queued) is done, the calling thread
+		runs tasks too while it waits. Only call it from outside the tasks
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Wait(void);
+		/*
+		USAGE: Gets the number of threads that run tasks, counting the one that calls Wait
+		ARGUMENTS: ---
+		OUTPUT: thread count
+		*/
+		uint GetThreadCount(void);
+
+	private:
+		/*
+		USAGE: Constructor, starts one thread less than the cores the machine has
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		MyThreadPool(void);
+		/*
+		USAGE: Copy Constructor
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyThreadPool(MyThreadPool const& other);
+		/*
+		USAGE: Copy Assignment Operator
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyThreadPool& operator=(MyThreadPool const& other);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyThreadPool(void);
+		/*
+		USAGE: Deallocates member fields, joins the threads
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Release(void);
+		/*
+		USAGE: Allocates member fields, starts the threads
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Init(void);
+		/*
+		USAGE: Loop of each worker, takes tasks until the pool stops
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void WorkerLoop(void);
+		/*
+		USAGE: Runs a task and marks it as done
+		ARGUMENTS: Task& a_Task -> task to run
+		OUTPUT: ---
+		*/
+		void Execute(Task& a_Task);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYTHREADPOOLCLASS_H_
+
+  /*
+  USAGE:
+  ARGUMENTS: ---
+  OUTPUT: ---
+  */
\ No newline at end of file